@@ -0,0 +1,99 @@
+// stand-in for the Arduino core, just what webserver_sketch.ino uses,
+// for the host build in this directory
+// flash and SRAM are one address space here, so the PROGMEM helpers
+// are plain memory accesses
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH    1
+#define LOW     0
+#define INPUT   0
+#define OUTPUT  1
+
+#define PROGMEM
+#define PGM_P               const char *
+#define PSTR(s)             (s)
+#define pgm_read_byte(p)    (*(const uint8_t *)(p))
+#define pgm_read_word(p)    PgmRead<uint16_t>(p)
+#define pgm_read_dword(p)   PgmRead<uint32_t>(p)
+#define pgm_read_ptr(p)     PgmRead<void *>(p)
+#define memcpy_P            memcpy
+#define strcpy_P            strcpy
+#define strcmp_P            strcmp
+#define strlen_P            strlen
+
+template <typename T> T PgmRead(const void *p) {
+    T v;
+
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+class __FlashStringHelper;
+#define F(s)    (reinterpret_cast<const __FlashStringHelper *>(PSTR(s)))
+
+#define constrain(x, lo, hi)    ((x) < (lo) ? (lo) : ((x) > (hi) ? (hi) : (x)))
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+
+char *itoa(int value, char *str, int base);
+char *ultoa(unsigned long value, char *str, int base);
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *data, size_t size);
+    virtual void flush() {}
+
+    size_t write(const char *str);
+    size_t print(const __FlashStringHelper *str);
+    size_t print(const char *str);
+    size_t print(char c);
+    size_t print(int value);
+    size_t print(unsigned int value);
+    size_t print(long value);
+    size_t print(unsigned long value);
+    size_t println(const __FlashStringHelper *str);
+    size_t println(const char *str);
+    size_t println(char c);
+    size_t println(int value);
+    size_t println(unsigned int value);
+    size_t println(long value);
+    size_t println(unsigned long value);
+    size_t println(void);
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+};
+
+// the serial port prints to stderr
+class HardwareSerial : public Stream {
+public:
+    void begin(unsigned long baud) {}
+    int available() { return 0; }
+    int read() { return -1; }
+    size_t write(uint8_t c);
+    using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+#endif
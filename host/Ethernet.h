@@ -0,0 +1,57 @@
+// stand-in for the Ethernet 2.0 library on a W5100, for the host build
+// the sockets are played by the harness through mock.h; the calls and
+// their costs follow the library: every write is sent as its own
+// segment, stop() waits for the client to answer the close up to the
+// connection timeout
+
+#ifndef HOST_ETHERNET_H
+#define HOST_ETHERNET_H
+
+#include "Arduino.h"
+
+#define MAX_SOCK_NUM    4
+
+class IPAddress {
+public:
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {}
+};
+
+class EthernetClient : public Stream {
+public:
+    EthernetClient() : sockindex(MAX_SOCK_NUM), timeout(1000) {}
+    explicit EthernetClient(uint8_t s) : sockindex(s), timeout(1000) {}
+
+    uint8_t connected();
+    int available();
+    int read();
+    int read(uint8_t *buf, size_t size);
+    int availableForWrite();
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buf, size_t size);
+    using Print::write;
+    void flush() {}
+    void stop();
+    void setConnectionTimeout(uint16_t ms);
+    uint8_t getSocketNumber() const { return sockindex; }
+    operator bool() { return sockindex < MAX_SOCK_NUM; }
+
+private:
+    uint8_t sockindex;
+    uint16_t timeout;
+};
+
+class EthernetServer {
+public:
+    EthernetServer(uint16_t port) {}
+    void begin() {}
+    EthernetClient accept();
+};
+
+class EthernetClass {
+public:
+    void begin(uint8_t *mac, IPAddress ip) {}
+};
+
+extern EthernetClass Ethernet;
+
+#endif
@@ -0,0 +1,43 @@
+// stand-in for the SD library, the card is a directory of the host,
+// see MockCard() in mock.h
+
+#ifndef HOST_SD_H
+#define HOST_SD_H
+
+#include "Arduino.h"
+
+#define FILE_READ   0
+
+struct MockFile;
+
+class File : public Stream {
+public:
+    File() : f(NULL) {}
+    explicit File(MockFile *mf) : f(mf) {}
+
+    int available();
+    int read();
+    int read(void *buf, uint16_t size);
+    size_t write(uint8_t c) { return 0; }
+    using Print::write;
+    uint32_t size();
+    char *name();
+    boolean isDirectory();
+    File openNextFile();
+    void close();
+    operator bool() { return f != NULL; }
+
+private:
+    MockFile *f;
+};
+
+class SDClass {
+public:
+    boolean begin(uint8_t csPin);
+    boolean exists(const char *path);
+    File open(const char *path, uint8_t mode = FILE_READ);
+};
+
+extern SDClass SD;
+
+#endif
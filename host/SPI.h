@@ -0,0 +1,2 @@
+// stand-in for the SPI library, the Ethernet and SD stand-ins do not
+// need it
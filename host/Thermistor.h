@@ -0,0 +1,13 @@
+// stand-in for the Thermistor library, the temperature is set by the
+// harness, see MockTemp() in mock.h
+
+#ifndef HOST_THERMISTOR_H
+#define HOST_THERMISTOR_H
+
+class Thermistor {
+public:
+    Thermistor(int pin) {}
+    int getTemp();
+};
+
+#endif
@@ -0,0 +1,275 @@
+// code of the sketch as it was before the rework, the benchmarks
+// compare the current code against it; kept as it was, the parts that
+// time the CPU take their bytes from memory, ServeClient() is loop()
+// with its socket and card calls, played by mock.h
+// include after the sketch, it uses its temp
+
+#ifndef HOST_BASELINE_H
+#define HOST_BASELINE_H
+
+#include "Arduino.h"
+#include "Ethernet.h"
+#include "SD.h"
+
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#pragma GCC diagnostic ignored "-Wchar-subscripts"
+
+namespace baseline {
+
+// size of buffer used to capture HTTP requests
+#define REQ_BUF_SZ   60
+#define BTN_NUM       5
+
+// buffered HTTP request stored as null terminated string
+char HTTP_req[REQ_BUF_SZ] = {0};
+// index into HTTP_req buffer
+char req_index = 0;
+boolean currentLineIsBlank = true;
+// stores the states of the RELAYs
+boolean RELAY_state[BTN_NUM] = {0};
+File webFile;
+
+// sets every element of str to 0 (clears array)
+void StrClear(char *str, char length) {
+    for (int i = 0; i < length; i++) {
+        str[i] = 0;
+    }
+}
+
+// searches for the string sfind in the string str
+// returns 1 if string found
+// returns 0 if string not found
+char StrContains(char *str, const char *sfind) {
+    char found = 0;
+    char index = 0;
+    char len;
+
+    len = strlen(str);
+
+    if (strlen(sfind) > len) {
+        return 0;
+    }
+    while (index < len) {
+        if (str[index] == sfind[found]) {
+            found++;
+
+            if (strlen(sfind) == found) {
+                return 1;
+            }
+        }
+        else {
+            found = 0;
+        }
+        index++;
+    }
+
+    return 0;
+}
+
+// checks if received HTTP request is switching on/off RELAYs
+// also saves the state of the RELAYs
+void SetRELAYs(void) {
+    // Living Room (pin 5)
+    if (StrContains(HTTP_req, "RELAY1=1")) {
+        RELAY_state[0] = 1;         // save Switch 1 state to On
+        digitalWrite(5, HIGH);
+    }
+    else if (StrContains(HTTP_req, "RELAY1=0")) {
+        RELAY_state[0] = 0;     // save Switch 1 state to OFF
+        digitalWrite(5, LOW);
+    }
+
+    // Master Bed (pin 6)
+    if (StrContains(HTTP_req, "RELAY2=1")) {
+        RELAY_state[1] = 1;         // save Switch 2 state to On
+        digitalWrite(6, HIGH);
+    }
+    else if (StrContains(HTTP_req, "RELAY2=0")) {
+        RELAY_state[1] = 0;     // save Switch 2 state to Off
+        digitalWrite(6, LOW);
+    }
+
+    // Guest Room (pin 9)
+    if (StrContains(HTTP_req, "RELAY3=1")) {
+        RELAY_state[2] = 1;         // save Switch 3 state to On
+        digitalWrite(9, HIGH);
+    }
+    else if (StrContains(HTTP_req, "RELAY3=0")) {
+        RELAY_state[2] = 0;     // save Switch 3 state to Off
+        digitalWrite(9, LOW);
+    }
+
+    // Kitchen (pin 7)
+    if (StrContains(HTTP_req, "RELAY4=1")) {
+        RELAY_state[3] = 1;         // save Switch 4 state to On
+        digitalWrite(8, HIGH);
+    }
+    else if (StrContains(HTTP_req, "RELAY4=0")) {
+        RELAY_state[3] = 0;     // save Switch 4 state to Off
+        digitalWrite(8, LOW);
+    }
+
+    // Wash Room (pin 9)
+    if (StrContains(HTTP_req, "RELAY5=1")) {
+        RELAY_state[4] = 1;         // save Switch 5 state to On
+        digitalWrite(7, HIGH);
+    }
+    else if (StrContains(HTTP_req, "RELAY5=0")) {
+        RELAY_state[4] = 0;     // save Switch 5 state to Off
+        digitalWrite(7, LOW);
+    }
+}
+
+// send the XML file with Temperature and Switch status
+// (took an EthernetClient, any Print will do)
+void XML_response(Print &cl) {
+    byte celsius = temp.getTemp();
+
+    cl.print("<?xml version = \"1.0\" ?>");
+    cl.print("<inputs>");
+
+        cl.print("<temp>");
+        cl.print(celsius);
+        cl.print("</temp>");
+
+        for(int i = 0; i < BTN_NUM; i++) {
+            cl.print("<BUTTON>");
+            if (RELAY_state[i]) {
+                cl.print("on");
+            }
+            else {
+                cl.print("off");
+            }
+            cl.println("</BUTTON>");
+        }
+
+    cl.print("</inputs>");
+}
+
+// what loop() sent for a button_state request
+void SendButtonState(Print &client) {
+    // send a standard http response header
+    client.println("HTTP/1.1 200 OK");
+    // send rest of HTTP header
+    client.println("Content-Type: text/xml");
+    client.println("Connection: keep-alive");
+    client.println();
+    SetRELAYs();
+    // send XML file containing input states
+    XML_response(client);
+}
+
+// the body of the receive loop of loop(), for the byte c read from
+// the client; true once the blank line ending the request has arrived
+boolean RequestByte(char c) {
+    // limit the size of the stored received HTTP request
+    // buffer first part of HTTP request in HTTP_req array (string)
+    // leave last element in array as 0 to null terminate string (REQ_BUF_SZ - 1)
+
+    if (req_index < (REQ_BUF_SZ - 1)) {
+        HTTP_req[req_index] = c;          // save HTTP request character
+        req_index++;
+    }
+    // last line of client request is blank and ends with \n
+    // respond to client only after last line received
+
+    if (c == '\n' && currentLineIsBlank) {
+        return true;
+    }
+    // every line of text received from the client ends with \r\n
+
+    if (c == '\n') {
+        // last character on line of received text
+        // starting new line with next character read
+        currentLineIsBlank = true;
+    }
+    else if (c != '\r') {
+        // a text character was received from client
+        currentLineIsBlank = false;
+    }
+    return false;
+}
+
+// what loop() did once the request had arrived, minus the response:
+// picks the response and switches the RELAYs, then resets the buffer
+// for the next request
+boolean RequestDone(void) {
+    boolean ajax = StrContains(HTTP_req, "button_state");
+
+    if (ajax) {
+        SetRELAYs();
+    }
+
+    // reset buffer index and all buffer elements to 0
+    req_index = 0;
+    StrClear(HTTP_req, REQ_BUF_SZ);
+    currentLineIsBlank = true;
+    return ajax;
+}
+
+// the body of loop() for a client that server.available() returned:
+// one available() and one read() per request byte, and for anything
+// but button_state index.htm from the card, one File.read() and one
+// write() per byte
+void ServeClient(EthernetClient client) {
+    if (client) {  // got client?
+        boolean currentLineIsBlank = true;
+
+        while (client.connected()) {
+            if (client.available()) {   // client data available to read
+                char c = client.read(); // read 1 byte (character) from client
+
+                if (req_index < (REQ_BUF_SZ - 1)) {
+                    HTTP_req[req_index] = c;          // save HTTP request character
+                    req_index++;
+                }
+                if (c == '\n' && currentLineIsBlank) {
+                    // send a standard http response header
+                    client.println("HTTP/1.1 200 OK");
+
+                    if (StrContains(HTTP_req, "button_state")) {
+                        // send rest of HTTP header
+                        client.println("Content-Type: text/xml");
+                        client.println("Connection: keep-alive");
+                        client.println();
+                        SetRELAYs();
+                        // send XML file containing input states
+                        XML_response(client);
+                    }
+
+                    else {  // web page request
+                        // send rest of HTTP header
+                        client.println("Content-Type: text/html");
+                        client.println("Connection: keep-alive");
+                        client.println();
+                        // send web page
+                        webFile = SD.open("index.htm");        // open web page file
+
+                        if (webFile) {
+                            while(webFile.available()) {
+                                client.write(webFile.read()); // send web page to client
+                            }
+                            webFile.close();
+                        }
+                    }
+                    // reset buffer index and all buffer elements to 0
+                    req_index = 0;
+                    StrClear(HTTP_req, REQ_BUF_SZ);
+                    break;
+                }
+                if (c == '\n') {
+                    currentLineIsBlank = true;
+                }
+                else if (c != '\r') {
+                    currentLineIsBlank = false;
+                }
+            } // end if (client.available())
+        } // end while (client.connected())
+        delay(1);      // give the web browser time to receive the data
+        client.stop(); // close the connection
+    } // end if (client)
+}
+
+}
+
+#endif
@@ -0,0 +1,526 @@
+// microbenchmarks of the sketch against the code it replaced, see
+// baseline.h
+//
+// usage: bench [name...]    runs the named benchmarks, all by default
+// run from host/ after tools/build_site.py, the card is ../build/sd
+//
+// the sketch is included, not linked, so that its internals can be
+// called directly; times are host CPU time, best of BENCH_RUNS runs,
+// comparable between the two sides of one benchmark only
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <time.h>
+#include "../webserver_sketch/webserver_sketch.ino"
+#include "baseline.h"
+#include "mock.h"
+
+#define BENCH_RUNS  5
+#define BENCH_ITER  100000
+
+// the requests of the dashboard, with the headers of a browser
+static const char POLL[] =
+    "GET /button_state&nocache=2267.0586 HTTP/1.1\r\n"
+    "Host: 192.168.0.20\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:115.0) Gecko/20100101 Firefox/115.0\r\n"
+    "Accept: */*\r\n"
+    "Accept-Language: en-US,en;q=0.5\r\n"
+    "Accept-Encoding: gzip, deflate\r\n"
+    "Referer: http://192.168.0.20/\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n";
+static const char SWITCH[] =
+    "GET /button_state&RELAY2=1&nocache=1931.1665 HTTP/1.1\r\n"
+    "Host: 192.168.0.20\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:115.0) Gecko/20100101 Firefox/115.0\r\n"
+    "Accept: */*\r\n"
+    "Accept-Language: en-US,en;q=0.5\r\n"
+    "Accept-Encoding: gzip, deflate\r\n"
+    "Referer: http://192.168.0.20/\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n";
+
+// five RELAY commands, the old buffer ends in the fifth one
+static const char LONG[] =
+    "GET /button_state&RELAY1=1&RELAY2=0&RELAY3=1&RELAY4=0&RELAY5=1&nocache=1234.56 HTTP/1.1\r\n"
+    "Host: 192.168.0.20\r\n"
+    "Connection: keep-alive\r\n"
+    "\r\n";
+
+// card played by the SD card, tools/build_site.py writes it
+#define BENCH_CARD  "../build/sd"
+
+// keeps the compiler from dropping the work measured
+static volatile unsigned long sink;
+
+static unsigned long long HostNs(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// ns per call of f, best of BENCH_RUNS runs of BENCH_ITER calls
+template <typename F> static double Time(F f) {
+    double best = 0;
+
+    for (int run = 0; run < BENCH_RUNS; run++) {
+        unsigned long long start = HostNs();
+
+        for (long i = 0; i < BENCH_ITER; i++) {
+            f();
+        }
+        double ns = (double)(HostNs() - start) / BENCH_ITER;
+
+        if (run == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+static void Compare(const char *what, double before, double after, const char *unit) {
+    printf("  %-24s before %8.2f  after %8.2f %s  (%.2fx)\n",
+           what, before, after, unit, before / after);
+}
+
+// calls into the Ethernet library so far, each of them several SPI
+// transactions with the W5100
+static unsigned long SocketCalls(void) {
+    return mock.accept + mock.connected + mock.available + mock.read +
+           mock.write + mock.availableForWrite + mock.stop;
+}
+
+// sends text on socket s and runs loop() until the sketch has answered
+// it, at most 100 passes of 1 ms; what it writes is taken right away
+static void SketchRequest(int s, const char *text) {
+    Conn *conn = &conns[s];
+    byte answered = conn->inUse ? conn->requests : 0;
+    std::string discard;
+
+    MockSend(s, text, strlen(text));
+    for (int i = 0; i < 100; i++) {
+        loop();
+        MockReceive(s, discard);
+        if (conn->inUse && conn->requests > answered) {
+            break;
+        }
+        MockAdvance(1000);
+    }
+}
+
+// closes the client end of socket s and runs loop() until the sketch
+// has closed its end
+static void SketchClose(int s) {
+    MockClose(s);
+    for (int i = 0; i < 100 && MockOpen(s); i++) {
+        loop();
+        MockAdvance(1000);
+    }
+}
+
+// the old loop() serving text on a new connection, which it closes
+static void BaselineRequest(const char *text) {
+    int s = MockConnect();
+    std::string discard;
+
+    MockSend(s, text, strlen(text));
+    baseline::ServeClient(server.accept());
+    MockReceive(s, discard);
+    MockClose(s);
+}
+
+// socket calls of a request from its arrival until it is answered: one
+// available() and one read() per byte before, a read() per RX_BUF_SZ
+// bytes now; the passes of loop() that find nothing to do on a kept
+// alive connection are not counted, see make run for those
+static void BenchRecv(void) {
+    static const struct {
+        const char *name;
+        const char *text;
+    } requests[] = {
+        {"poll", POLL},
+        {"switch", SWITCH},
+    };
+
+    printf("recv: socket calls per request, accept to answer\n");
+    for (const auto &r : requests) {
+        unsigned long before, first, next;
+        unsigned long calls = SocketCalls();
+        int s;
+
+        BaselineRequest(r.text);
+        before = SocketCalls() - calls;
+
+        s = MockConnect();
+        calls = SocketCalls();
+        SketchRequest(s, r.text);
+        first = SocketCalls() - calls;
+        calls = SocketCalls();
+        SketchRequest(s, r.text);
+        next = SocketCalls() - calls;
+        SketchClose(s);
+
+        printf("  %-24s before %8lu  after %8lu first, %lu kept alive (%.1fx)\n",
+               r.name, before, first, next, (double)before / first);
+    }
+}
+
+// a request from its first byte until the server knows what to answer
+// and which RELAYs to switch: buffered into HTTP_req and searched with
+// StrContains() before, parsed byte by byte as it arrives now; before
+// only looked at the first REQ_BUF_SZ - 1 bytes, now every header is
+// parsed
+static void BenchParse(void) {
+    static const struct {
+        const char *name;
+        const char *text;
+    } requests[] = {
+        {"poll", POLL},
+        {"switch", SWITCH},
+        {"long query", LONG},
+    };
+
+    printf("parse: ns per request byte\n");
+    for (const auto &r : requests) {
+        size_t len = strlen(r.text);
+        double before = Time([&] {
+            for (size_t i = 0; i < len; i++) {
+                if (baseline::RequestByte(r.text[i])) {
+                    sink += baseline::RequestDone();
+                    break;
+                }
+            }
+        });
+        double after = Time([&] {
+            HttpRequest req;
+
+            RequestBegin(&req);
+            for (size_t i = 0; i < len; i++) {
+                if (RequestParse(&req, r.text[i]) == PS_DONE) {
+                    break;
+                }
+            }
+            sink += req.pathHash;
+        });
+
+        Compare(r.name, before / len, after / len, "ns");
+    }
+
+    // RELAY commands seen in LONG, digitalWrite() once per command before
+    HttpRequest req;
+    unsigned long writes = mock.digitalWrite;
+
+    for (const char *p = LONG; !baseline::RequestByte(*p); p++) {
+    }
+    baseline::RequestDone();
+    writes = mock.digitalWrite - writes;
+    RequestBegin(&req);
+    for (const char *p = LONG; RequestParse(&req, *p) != PS_DONE; p++) {
+    }
+    printf("  %-24s before %8lu  after %8d of 5\n", "RELAY commands seen",
+           writes, __builtin_popcount(req.relayOn | req.relayOff));
+}
+
+// the RELAY commands of a query string: ten StrContains() calls over
+// HTTP_req before, one RelayMatch() step per query character now, fed
+// as RequestParse() feeds it
+static void BenchMatch(void) {
+    static const struct {
+        const char *name;
+        const char *query;
+    } queries[] = {
+        {"poll", "nocache=2267.0586"},
+        {"switch", "RELAY2=1&nocache=1931.1665"},
+        {"five switches", "RELAY1=1&RELAY2=0&RELAY3=1&RELAY4=0&RELAY5=1&nocache=1234.56"},
+    };
+
+    printf("match: ns per query string\n");
+    for (const auto &q : queries) {
+        size_t len = strlen(q.query);
+
+        snprintf(baseline::HTTP_req, REQ_BUF_SZ, "GET /button_state&%s", q.query);
+        double before = Time([&] {
+            baseline::SetRELAYs();
+            sink += baseline::RELAY_state[1];
+        });
+        double after = Time([&] {
+            HttpRequest req;
+
+            req.relayMatch = 0;
+            req.relayOn = 0;
+            req.relayOff = 0;
+            req.waitMatch = WM_KEY;
+            for (size_t i = 0; i <= len; i++) {
+                char c = q.query[i];
+
+                if (c == '&' || c == '\0') {
+                    QueryParam(&req);
+                }
+                else {
+                    RelayMatch(&req, c);
+                }
+            }
+            sink += req.relayOn;
+        });
+
+        Compare(q.name, before, after, "ns");
+    }
+}
+
+// CPU time of answering a poll, the response written to a socket whose
+// client takes it right away: formatted with print() calls on every
+// poll before, pre-rendered in XML_resp and written as it is now
+static void BenchPoll(void) {
+    Conn *conn = &conns[0];
+    int sock = MockConnect();
+    std::string discard;
+    unsigned long writes;
+    double before, after;
+
+    XML_init();
+    conn->client = server.accept();
+
+    writes = mock.write;
+    before = Time([&] {
+        baseline::SendButtonState(conn->client);
+        MockReceive(sock, discard);
+        discard.clear();
+    });
+    writes = (mock.write - writes) / (BENCH_RUNS * BENCH_ITER);
+
+    unsigned long newWrites = mock.write;
+    after = Time([&] {
+        RequestBegin(&conn->req);
+        SendButtonState(conn);
+        MockReceive(sock, discard);
+        discard.clear();
+    });
+    newWrites = (mock.write - newWrites) / (BENCH_RUNS * BENCH_ITER);
+
+    printf("poll: button_state response\n");
+    Compare("CPU time", before, after, "ns");
+    printf("  %-24s before %8lu  after %8lu\n", "writes (TCP segments)", writes, newWrites);
+    MockClose(sock);
+    conn->client.stop();
+}
+
+// the requests of a visit besides the poll: the page, the icon the
+// browser asks for by itself, and a path the server does not have
+static const char *const VISIT[] = { "/", "/favicon.ico", "/nosuch" };
+
+// card and socket work of each request of a visit: the old loop()
+// streamed index.htm from the card for any path but button_state, one
+// read() per byte; the page comes from flash or the card now, the icon
+// gets a 204 and an unknown path a 404 of only a header; both sides
+// read the index.htm of the card, which is smaller than the old page
+static void BenchVisit(void) {
+    const int n = sizeof(VISIT) / sizeof(VISIT[0]);
+    unsigned long counts[2][n + 1][4] = {};
+    char text[128];
+    int s = -1;
+
+    printf("visit: SD opens/reads/bytes read, socket bytes written\n");
+    for (int side = 0; side < 2; side++) {
+        // the old loop() accepts any socket, so the kept alive one of
+        // the sketch is opened after it is done
+        if (side == 1) {
+            s = MockConnect();
+        }
+        for (int i = 0; i < n; i++) {
+            MockCounters start = mock;
+
+            snprintf(text, sizeof(text),
+                     "GET %s HTTP/1.1\r\n"
+                     "Host: 192.168.0.20\r\n"
+                     "Accept-Encoding: gzip, deflate\r\n\r\n", VISIT[i]);
+            if (side == 0) {
+                BaselineRequest(text);
+            }
+            else {
+                SketchRequest(s, text);
+            }
+            counts[side][i][0] = mock.sdOpen - start.sdOpen;
+            counts[side][i][1] = mock.sdRead - start.sdRead;
+            counts[side][i][2] = mock.sdBytes - start.sdBytes;
+            counts[side][i][3] = mock.bytesWritten - start.bytesWritten;
+            for (int k = 0; k < 4; k++) {
+                counts[side][n][k] += counts[side][i][k];
+            }
+        }
+    }
+    SketchClose(s);
+
+    for (int i = 0; i <= n; i++) {
+        printf("  %-12s before %lu/%lu/%lu %lu  after %lu/%lu/%lu %lu\n",
+               (i < n) ? VISIT[i] : "visit",
+               counts[0][i][0], counts[0][i][1], counts[0][i][2], counts[0][i][3],
+               counts[1][i][0], counts[1][i][1], counts[1][i][2], counts[1][i][3]);
+    }
+}
+
+// RELAY commands of a user, at ACTUATE_PRESSES pseudo-random times,
+// to clients ACTUATE_RTT_MS away
+#define ACTUATE_PRESSES 200
+#define ACTUATE_RTT_MS  20
+#define ACTUATE_POLL_MS 1000
+// output pin of RELAY1, as in RELAY_pin[]
+#define ACTUATE_PIN     5
+
+// runs loop() for ms in passes of 1 ms, what it writes to socket s is
+// taken right away
+static void SketchIdle(int s, unsigned long ms) {
+    std::string discard;
+
+    for (unsigned long i = 0; i < ms; i++) {
+        loop();
+        MockReceive(s, discard);
+        MockAdvance(1000);
+    }
+}
+
+// runs loop() until the RELAY1 pin is written after at, at most 100
+// passes of 1 ms
+static void SketchActuate(int s, unsigned long long at) {
+    std::string discard;
+
+    for (int i = 0; i < 100 && MockPinAt(ACTUATE_PIN) <= at; i++) {
+        loop();
+        MockReceive(s, discard);
+        if (MockPinAt(ACTUATE_PIN) > at) {
+            break;
+        }
+        MockAdvance(1000);
+    }
+}
+
+static void PrintLatency(const char *what, std::vector<unsigned long long> &us,
+                         unsigned long calls) {
+    std::sort(us.begin(), us.end());
+    printf("  %-24s p50 %7.1f  p99 %7.1f ms  %6lu socket calls\n", what,
+           us[us.size() / 2] / 1000.0, us[us.size() * 99 / 100] / 1000.0,
+           calls / (unsigned long)us.size());
+}
+
+// simulated time from a click on a RELAY button until the pin is
+// written: the old page sent the command with its next poll, every
+// ACTUATE_POLL_MS, on a new connection; the page sends it right away
+// now, on its kept alive connection or on the WebSocket; time does not
+// move while the sketch runs, so the figures are of the network and
+// the polling, the socket calls handling each command are the part
+// the board adds to them
+static void BenchActuate(void) {
+    std::vector<unsigned long long> before, get, ws;
+    unsigned long beforeCalls = 0, getCalls = 0, wsCalls = 0;
+    unsigned long seed = 1;
+    std::string discard;
+    char text[128];
+    int s;
+
+    printf("actuate: click to RELAY pin, rtt %d ms\n", ACTUATE_RTT_MS);
+    MockRtt(ACTUATE_RTT_MS);
+
+    for (int i = 0; i < ACTUATE_PRESSES; i++) {
+        seed = seed * 1103515245 + 12345;
+        unsigned long phase = (seed >> 16) % ACTUATE_POLL_MS;
+        unsigned long long press;
+        unsigned long calls;
+
+        // the click lands phase ms after the last poll was sent, the
+        // next one connects, then sends the command
+        MockAdvance(phase * 1000);
+        press = MockNow();
+        MockAdvance((ACTUATE_POLL_MS - phase) * 1000ULL + ACTUATE_RTT_MS * 1000 +
+                    ACTUATE_RTT_MS * 500);
+        snprintf(text, sizeof(text),
+                 "GET /button_state&RELAY1=%d&nocache=1931.1665 HTTP/1.1\r\n"
+                 "Host: 192.168.0.20\r\n\r\n", i & 1);
+        calls = SocketCalls();
+        BaselineRequest(text);
+        beforeCalls += SocketCalls() - calls;
+        before.push_back(MockPinAt(ACTUATE_PIN) - press);
+    }
+
+    s = MockConnect();
+    SketchRequest(s, POLL);
+    for (int i = 0; i < ACTUATE_PRESSES; i++) {
+        seed = seed * 1103515245 + 12345;
+        unsigned long long press;
+        unsigned long calls;
+
+        SketchIdle(s, (seed >> 16) % ACTUATE_POLL_MS);
+        press = MockNow();
+        MockAdvance(ACTUATE_RTT_MS * 500);
+        snprintf(text, sizeof(text),
+                 "GET /state.json?RELAY1=%d HTTP/1.1\r\n"
+                 "Host: 192.168.0.20\r\n\r\n", i & 1);
+        calls = SocketCalls();
+        MockSend(s, text, strlen(text));
+        SketchActuate(s, press);
+        getCalls += SocketCalls() - calls;
+        get.push_back(MockPinAt(ACTUATE_PIN) - press);
+    }
+    SketchClose(s);
+
+    static const char UPGRADE[] =
+        "GET /ws HTTP/1.1\r\n"
+        "Host: 192.168.0.20\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+        "Sec-WebSocket-Version: 13\r\n\r\n";
+    s = MockConnect();
+    MockSend(s, UPGRADE, strlen(UPGRADE));
+    SketchIdle(s, 10);
+    for (int i = 0; i < ACTUATE_PRESSES; i++) {
+        seed = seed * 1103515245 + 12345;
+        // a masked binary frame of one byte, the mask is 0x37fa213d
+        char frame[] = { (char)0x82, (char)0x81, 0x37, (char)0xfa, 0x21, 0x3d,
+                         (char)((1 | ((i & 1) ? 0x80 : 0)) ^ 0x37) };
+        unsigned long long press;
+        unsigned long calls;
+
+        SketchIdle(s, (seed >> 16) % ACTUATE_POLL_MS);
+        press = MockNow();
+        MockAdvance(ACTUATE_RTT_MS * 500);
+        calls = SocketCalls();
+        MockSend(s, frame, sizeof(frame));
+        SketchActuate(s, press);
+        wsCalls += SocketCalls() - calls;
+        ws.push_back(MockPinAt(ACTUATE_PIN) - press);
+    }
+    SketchClose(s);
+
+    PrintLatency("button_state poll before", before, beforeCalls);
+    PrintLatency("state.json GET", get, getCalls);
+    PrintLatency("WebSocket frame", ws, wsCalls);
+}
+
+static const struct {
+    const char *name;
+    void (*run)(void);
+} BENCHES[] = {
+    {"parse", BenchParse},
+    {"match", BenchMatch},
+    {"poll", BenchPoll},
+    {"recv", BenchRecv},
+    {"visit", BenchVisit},
+    {"actuate", BenchActuate},
+};
+
+int main(int argc, char **argv) {
+    MockCard(BENCH_CARD);
+    setup();
+    for (const auto &b : BENCHES) {
+        boolean run = (argc == 1);
+
+        for (int i = 1; i < argc; i++) {
+            run |= (strcmp(argv[i], b.name) == 0);
+        }
+        if (run) {
+            b.run();
+        }
+    }
+    return 0;
+}
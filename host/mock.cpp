@@ -0,0 +1,494 @@
+// stand-ins for the Arduino core and the libraries used by the sketch,
+// see mock.h
+
+#include <dirent.h>
+#include <string>
+#include "Arduino.h"
+#include "Ethernet.h"
+#include "SD.h"
+#include "Thermistor.h"
+#include "mock.h"
+
+MockCounters mock;
+HardwareSerial Serial;
+EthernetClass Ethernet;
+SDClass SD;
+
+static unsigned long long nowUs = 0;
+static unsigned long rttUs = 20000;
+static int celsius = 23;
+static uint8_t pins[20];
+static unsigned long long pinsAt[20];
+
+// Arduino core
+
+unsigned long millis(void) {
+    mock.millis++;
+    return (unsigned long)(nowUs / 1000);
+}
+
+unsigned long micros(void) {
+    return (unsigned long)nowUs;
+}
+
+void delay(unsigned long ms) {
+    nowUs += ms * 1000ULL;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    mock.digitalWrite++;
+    if (pin < sizeof(pins)) {
+        pins[pin] = value;
+        pinsAt[pin] = nowUs;
+    }
+}
+
+char *ultoa(unsigned long value, char *str, int base) {
+    char digits[33];
+    int n = 0;
+    char *p = str;
+
+    do {
+        int d = value % base;
+
+        digits[n++] = (d < 10) ? '0' + d : 'a' + d - 10;
+        value /= base;
+    } while (value);
+    while (n) {
+        *p++ = digits[--n];
+    }
+    *p = '\0';
+    return str;
+}
+
+char *itoa(int value, char *str, int base) {
+    if (value < 0 && base == 10) {
+        *str = '-';
+        ultoa(-(long)value, str + 1, base);
+        return str;
+    }
+    return ultoa((unsigned int)value, str, base);
+}
+
+size_t Print::write(const uint8_t *data, size_t size) {
+    size_t n = 0;
+
+    while (size--) {
+        n += write(*data++);
+    }
+    return n;
+}
+
+size_t Print::write(const char *str) {
+    return write((const uint8_t *)str, strlen(str));
+}
+
+size_t Print::print(const __FlashStringHelper *str) {
+    return write((const char *)str);
+}
+
+size_t Print::print(const char *str) {
+    return write(str);
+}
+
+size_t Print::print(char c) {
+    return write((uint8_t)c);
+}
+
+size_t Print::print(int value) {
+    return print((long)value);
+}
+
+size_t Print::print(unsigned int value) {
+    return print((unsigned long)value);
+}
+
+size_t Print::print(long value) {
+    char buf[24];
+
+    snprintf(buf, sizeof(buf), "%ld", value);
+    return write(buf);
+}
+
+size_t Print::print(unsigned long value) {
+    char buf[24];
+
+    snprintf(buf, sizeof(buf), "%lu", value);
+    return write(buf);
+}
+
+size_t Print::println(void) {
+    return write("\r\n");
+}
+
+size_t Print::println(const __FlashStringHelper *str) {
+    return print(str) + println();
+}
+
+size_t Print::println(const char *str) {
+    return print(str) + println();
+}
+
+size_t Print::println(char c) {
+    return print(c) + println();
+}
+
+size_t Print::println(int value) {
+    return print(value) + println();
+}
+
+size_t Print::println(unsigned int value) {
+    return print(value) + println();
+}
+
+size_t Print::println(long value) {
+    return print(value) + println();
+}
+
+size_t Print::println(unsigned long value) {
+    return print(value) + println();
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    fputc(c, stderr);
+    return 1;
+}
+
+// W5100 sockets
+
+struct MockSock {
+    boolean open;       // the sketch has not closed it
+    boolean held;       // the client has not let go of it
+    boolean accepted;
+    boolean peerClosed;
+    boolean stalled;
+    std::string rx;     // sent by the client
+    size_t rxPos;       // read by the sketch up to here
+    std::string tx;     // written by the sketch, not yet taken
+};
+
+static MockSock socks[MAX_SOCK_NUM];
+
+void MockRtt(unsigned long ms) {
+    rttUs = ms * 1000;
+}
+
+void MockAdvance(unsigned long us) {
+    nowUs += us;
+}
+
+unsigned long long MockNow(void) {
+    return nowUs;
+}
+
+int MockConnect(void) {
+    for (int i = 0; i < MAX_SOCK_NUM; i++) {
+        MockSock &s = socks[i];
+
+        if (!s.open && !s.held) {
+            s = MockSock();
+            s.open = true;
+            s.held = true;
+            return i;
+        }
+    }
+    return -1;
+}
+
+void MockSend(int s, const char *data, size_t n) {
+    socks[s].rx.append(data, n);
+}
+
+size_t MockReceive(int s, std::string &out) {
+    MockSock &sock = socks[s];
+    size_t n = sock.tx.size();
+
+    if (sock.stalled) {
+        return 0;
+    }
+    out += sock.tx;
+    sock.tx.clear();
+    return n;
+}
+
+void MockStall(int s, boolean stalled) {
+    socks[s].stalled = stalled;
+}
+
+void MockClose(int s) {
+    socks[s].peerClosed = true;
+    socks[s].held = false;
+}
+
+boolean MockOpen(int s) {
+    return socks[s].open;
+}
+
+EthernetClient EthernetServer::accept() {
+    mock.accept++;
+    for (uint8_t i = 0; i < MAX_SOCK_NUM; i++) {
+        if (socks[i].open && !socks[i].accepted) {
+            socks[i].accepted = true;
+            return EthernetClient(i);
+        }
+    }
+    return EthernetClient();
+}
+
+// like the library, true until the client has closed its end and
+// every byte it sent has been read
+uint8_t EthernetClient::connected() {
+    mock.connected++;
+    if (sockindex >= MAX_SOCK_NUM) {
+        return 0;
+    }
+    MockSock &s = socks[sockindex];
+    return s.open && !(s.peerClosed && s.rxPos == s.rx.size());
+}
+
+int EthernetClient::available() {
+    mock.available++;
+    if (sockindex >= MAX_SOCK_NUM || !socks[sockindex].open) {
+        return 0;
+    }
+    return socks[sockindex].rx.size() - socks[sockindex].rxPos;
+}
+
+int EthernetClient::read() {
+    uint8_t c;
+
+    return (read(&c, 1) == 1) ? c : -1;
+}
+
+int EthernetClient::read(uint8_t *buf, size_t size) {
+    mock.read++;
+    if (sockindex >= MAX_SOCK_NUM) {
+        return 0;
+    }
+    MockSock &s = socks[sockindex];
+    size_t n = s.rx.size() - s.rxPos;
+
+    if (n == 0) {
+        return -1;
+    }
+    if (n > size) {
+        n = size;
+    }
+    memcpy(buf, s.rx.data() + s.rxPos, n);
+    s.rxPos += n;
+    mock.bytesRead += n;
+    return n;
+}
+
+int EthernetClient::availableForWrite() {
+    mock.availableForWrite++;
+    if (sockindex >= MAX_SOCK_NUM || !socks[sockindex].open) {
+        return 0;
+    }
+    return MOCK_TX_SZ - socks[sockindex].tx.size();
+}
+
+size_t EthernetClient::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+// a write the socket has no room for blocks in the library until the
+// client has taken enough, a round trip at least; a stalled client
+// never does, the bytes are lost when the socket is closed
+size_t EthernetClient::write(const uint8_t *buf, size_t size) {
+    mock.write++;
+    if (sockindex >= MAX_SOCK_NUM || !socks[sockindex].open) {
+        return 0;
+    }
+    MockSock &s = socks[sockindex];
+
+    if (s.tx.size() + size > MOCK_TX_SZ) {
+        mock.blockedWrites++;
+        nowUs += rttUs;
+    }
+    s.tx.append((const char *)buf, size);
+    mock.bytesWritten += size;
+    return size;
+}
+
+// like the library, waits for the client to answer the close, up to
+// the connection timeout; a stalled client never answers
+void EthernetClient::stop() {
+    mock.stop++;
+    if (sockindex >= MAX_SOCK_NUM) {
+        return;
+    }
+    MockSock &s = socks[sockindex];
+    unsigned long waitUs = timeout * 1000UL;
+
+    if (!s.open) {
+        return;
+    }
+    if (!s.stalled && rttUs < waitUs) {
+        waitUs = rttUs;
+    }
+    if (s.stalled) {
+        mock.lostBytes += s.tx.size();
+        s.tx.clear();
+    }
+    nowUs += waitUs;
+    mock.stopWaitUs += waitUs;
+    if (waitUs > mock.stopWaitMaxUs) {
+        mock.stopWaitMaxUs = waitUs;
+    }
+    s.open = false;
+    sockindex = MAX_SOCK_NUM;
+}
+
+void EthernetClient::setConnectionTimeout(uint16_t ms) {
+    mock.setConnectionTimeout++;
+    timeout = ms;
+}
+
+// SD card, a directory of the host
+
+static std::string cardDir;
+
+struct MockFile {
+    FILE *f;
+    DIR *d;
+    std::string dir;
+    std::string name;
+    uint32_t size;
+};
+
+static MockFile *FileOpen(const std::string &dir, const std::string &name) {
+    std::string path = dir + "/" + name;
+    MockFile *mf = new MockFile();
+
+    mf->name = name;
+    mf->d = opendir(path.c_str());
+    mf->f = mf->d ? NULL : fopen(path.c_str(), "rb");
+    mf->dir = path;
+    if (!mf->d && !mf->f) {
+        delete mf;
+        return NULL;
+    }
+    if (mf->f) {
+        fseek(mf->f, 0, SEEK_END);
+        mf->size = ftell(mf->f);
+        fseek(mf->f, 0, SEEK_SET);
+    }
+    return mf;
+}
+
+void MockCard(const char *dir) {
+    cardDir = dir ? dir : "";
+}
+
+boolean SDClass::begin(uint8_t csPin) {
+    DIR *d;
+
+    if (cardDir.empty() || !(d = opendir(cardDir.c_str()))) {
+        return false;
+    }
+    closedir(d);
+    return true;
+}
+
+boolean SDClass::exists(const char *path) {
+    File f = open(path);
+
+    if (!f) {
+        return false;
+    }
+    f.close();
+    return true;
+}
+
+File SDClass::open(const char *path, uint8_t mode) {
+    mock.sdOpen++;
+    if (cardDir.empty()) {
+        return File();
+    }
+    while (*path == '/') {
+        path++;
+    }
+    return File(FileOpen(cardDir, path));
+}
+
+int File::available() {
+    return f->f ? f->size - ftell(f->f) : 0;
+}
+
+int File::read() {
+    uint8_t c;
+
+    return (read(&c, 1) == 1) ? c : -1;
+}
+
+int File::read(void *buf, uint16_t size) {
+    size_t n;
+
+    mock.sdRead++;
+    if (!f->f) {
+        return -1;
+    }
+    n = fread(buf, 1, size, f->f);
+    mock.sdBytes += n;
+    return n;
+}
+
+uint32_t File::size() {
+    return f->f ? f->size : 0;
+}
+
+char *File::name() {
+    return (char *)f->name.c_str();
+}
+
+boolean File::isDirectory() {
+    return f->d != NULL;
+}
+
+File File::openNextFile() {
+    struct dirent *e;
+
+    while (f->d && (e = readdir(f->d))) {
+        if (e->d_name[0] != '.') {
+            return File(FileOpen(f->dir, e->d_name));
+        }
+    }
+    return File();
+}
+
+void File::close() {
+    if (!f) {
+        return;
+    }
+    if (f->f) {
+        fclose(f->f);
+    }
+    if (f->d) {
+        closedir(f->d);
+    }
+    delete f;
+    f = NULL;
+}
+
+// thermistor and pins
+
+void MockTemp(int c) {
+    celsius = c;
+}
+
+int Thermistor::getTemp() {
+    mock.getTemp++;
+    return celsius;
+}
+
+int MockPin(uint8_t pin) {
+    return pins[pin];
+}
+
+unsigned long long MockPinAt(uint8_t pin) {
+    return pinsAt[pin];
+}
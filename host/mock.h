@@ -0,0 +1,73 @@
+// the harness side of the stand-ins: plays the clients of the W5100
+// sockets, the SD card, the pins and the thermistor, and counts every
+// call the sketch makes into them
+// time is simulated, it only moves with MockAdvance(), delay() and
+// the waits of EthernetClient::stop()
+
+#ifndef HOST_MOCK_H
+#define HOST_MOCK_H
+
+#include <string>
+#include "Arduino.h"
+
+// bytes of the transmit buffer of each W5100 socket
+#define MOCK_TX_SZ  2048
+
+struct MockCounters {
+    // calls into the Ethernet library
+    unsigned long accept;
+    unsigned long connected;
+    unsigned long available;
+    unsigned long read;
+    unsigned long write;
+    unsigned long availableForWrite;
+    unsigned long stop;
+    unsigned long setConnectionTimeout;
+    unsigned long bytesRead;
+    unsigned long bytesWritten;
+    // writes bigger than the room left in the socket, the library
+    // waits inside write() until the client has taken enough
+    unsigned long blockedWrites;
+    // bytes written to a client that never took them, cut off when
+    // the socket was closed
+    unsigned long lostBytes;
+    // simulated time spent inside stop()
+    unsigned long stopWaitUs;
+    unsigned long stopWaitMaxUs;
+    // calls into the SD card, the pins and the thermistor
+    unsigned long sdOpen;
+    unsigned long sdRead;
+    unsigned long sdBytes;
+    unsigned long digitalWrite;
+    unsigned long getTemp;
+    unsigned long millis;
+};
+
+extern MockCounters mock;
+
+// a client connects, returns its socket or -1 when none is free
+int MockConnect(void);
+// the client of socket s sends n bytes
+void MockSend(int s, const char *data, size_t n);
+// the client of socket s takes what the sketch wrote, appended to out;
+// returns the number of bytes taken
+size_t MockReceive(int s, std::string &out);
+// a stalled client takes nothing, its socket fills up
+void MockStall(int s, boolean stalled);
+// the client of socket s closes its end and lets go of the socket
+void MockClose(int s);
+// true while the sketch has not closed socket s
+boolean MockOpen(int s);
+// round trip time to the clients, stop() waits for it
+void MockRtt(unsigned long ms);
+// simulated time in microseconds
+void MockAdvance(unsigned long us);
+unsigned long long MockNow(void);
+// directory played by the SD card, NULL for no card
+void MockCard(const char *dir);
+void MockTemp(int celsius);
+// last value written to pin, and the simulated time it was written
+int MockPin(uint8_t pin);
+unsigned long long MockPinAt(uint8_t pin);
+
+#endif
@@ -0,0 +1,89 @@
+// time a client takes to read the state from each format the server
+// sends, the body of one answer each, as the sketch renders it for
+// RELAY1 and RELAY3 on at 23 degrees
+//
+// usage: node parse_bench.js      the JSON and text forms
+//        parse_bench.htm          in a browser, also the XML form, which
+//                                 needs the browser's DOMParser
+//
+// the XML is read as the page read button_state before the rework, the
+// JSON as app.js reads state.json, the text form as "<mask> <temp>"
+
+var RUNS = 5;
+var ITER = 20000;
+
+var XML_BODY = "<?xml version = \"1.0\" ?><inputs><temp>23</temp>  " +
+  "<BUTTON>on</BUTTON> \r\n<BUTTON>off</BUTTON>\r\n<BUTTON>on</BUTTON> \r\n" +
+  "<BUTTON>off</BUTTON>\r\n<BUTTON>off</BUTTON>\r\n</inputs>";
+var JSON_BODY = "{\"relays\":5,\"temp\":23}";
+var TEXT_BODY = "5 23";
+
+// keeps the work measured from being dropped
+var sink = 0;
+
+function ReadXml(text) {
+  var xml = new DOMParser().parseFromString(text, "text/xml");
+  var buttons = xml.getElementsByTagName("BUTTON");
+
+  for (var i = 0; i < buttons.length; i++) {
+    if (buttons[i].childNodes[0].nodeValue === "on") {
+      sink++;
+    }
+  }
+  sink += parseInt(xml.getElementsByTagName("temp")[0].childNodes[0].nodeValue, 10);
+}
+
+function ReadJson(text) {
+  var state = JSON.parse(text);
+
+  sink += state.relays + state.temp;
+}
+
+function ReadText(text) {
+  var fields = text.split(" ");
+
+  sink += parseInt(fields[0], 10) + parseInt(fields[1], 10);
+}
+
+// microseconds per call of read on body, best of RUNS runs
+function Time(read, body) {
+  var best = 0;
+
+  for (var run = 0; run < RUNS; run++) {
+    var start = performance.now();
+
+    for (var i = 0; i < ITER; i++) {
+      read(body);
+    }
+    var us = (performance.now() - start) * 1000 / ITER;
+
+    if (run === 0 || us < best) {
+      best = us;
+    }
+  }
+  return best;
+}
+
+function Report(print) {
+  var formats = [
+    { name: "button_state XML", read: ReadXml, body: XML_BODY },
+    { name: "state.json", read: ReadJson, body: JSON_BODY },
+    { name: "state text", read: ReadText, body: TEXT_BODY },
+  ];
+
+  print("client parse time per answer");
+  formats.forEach(function(f) {
+    var line = "  " + (f.name + "                ").slice(0, 18) +
+               ("    " + f.body.length).slice(-4) + " bytes  ";
+
+    if (f.read === ReadXml && typeof DOMParser === "undefined") {
+      print(line + "needs a browser, open parse_bench.htm");
+      return;
+    }
+    print(line + Time(f.read, f.body).toFixed(3) + " us");
+  });
+}
+
+if (typeof window === "undefined") {
+  Report(console.log);
+}
@@ -0,0 +1,446 @@
+// replays the traffic of dashboard clients against the sketch and
+// reports its throughput, handler latency, bytes and library calls
+//
+// usage: replay [-c clients] [-w websockets] [-s stalled] [-k] [-b]
+//               [-r rtt_ms] [-d card_dir] [trace]
+//
+// every client loads the page and its files, then sends the requests
+// of the trace one after the other, each at its time or as soon as the
+// answer to the one before has arrived, or -b back to back without
+// waiting for the times, to load the server fully; -k makes the clients ask for
+// Connection: close, -w opens WebSockets to /ws that are held for the
+// whole run and reopened when the server closes them, -s opens clients
+// that send requests and never read the answers
+//
+// a trace has one request per line, the time in ms from the start and
+// the request target: 1000 /button_state&nocache=4213.7
+//
+// handler latency is the host time spent in loop() while the request
+// was waiting for its answer; requests/s is the number of requests
+// over the host time spent in those passes of loop(), and over their
+// simulated time: PASS_US a pass plus the waits inside the libraries
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <time.h>
+#include <unistd.h>
+#include "Arduino.h"
+#include "Ethernet.h"
+#include "mock.h"
+
+void setup(void);
+void loop(void);
+extern unsigned int drops[];
+
+// simulated time of a pass of loop() while there is work, and of an
+// idle pass
+#define PASS_US     1000
+#define IDLE_US     10000
+// clients start their replay this far apart
+#define STAGGER_MS  250
+// the page reopens a WebSocket the server closed after this long
+#define REOPEN_MS   2000
+// time given to the server after the last request of the trace
+#define TAIL_MS     1000
+
+struct TraceLine {
+    unsigned long ms;
+    std::string target;
+};
+
+struct Client {
+    int sock;                   // -1 while not connected
+    size_t next;                // next line of the trace
+    unsigned long long startUs; // time the replay starts
+    std::vector<std::string> files;     // of the page, fetched next
+    boolean busy;               // waiting for an answer
+    boolean closing;            // answered with Connection: close
+    std::string target;
+    std::string in;             // answer so far
+    unsigned long long hostNs;  // loop() time since the request
+    unsigned long long sentUs;
+};
+
+struct Socket {
+    int sock;
+    unsigned long long reopenUs;
+    std::string in;
+    boolean open;
+};
+
+static std::vector<TraceLine> trace;
+static std::vector<Client> clients;
+static std::vector<Socket> sockets;
+static std::vector<unsigned long long> latencyNs;
+static std::vector<unsigned long long> responseUs;
+static boolean keepAlive = true;
+static boolean backToBack = false;
+static unsigned long requests = 0;
+static unsigned long failed = 0;
+static unsigned long connections = 0;
+static unsigned long connectWaits = 0;
+static unsigned long wsOpens = 0;
+static unsigned long long busyNs = 0;
+static unsigned long long busyUs = 0;
+static unsigned long long idleNs = 0;
+static unsigned long busyPasses = 0;
+static unsigned long idlePasses = 0;
+
+static unsigned long long HostNs(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static boolean LoadTrace(const char *path) {
+    FILE *f = fopen(path, "r");
+    char target[512];
+    unsigned long ms;
+
+    if (!f) {
+        return false;
+    }
+    while (fscanf(f, "%lu %511s", &ms, target) == 2) {
+        trace.push_back(TraceLine{ms, target});
+    }
+    fclose(f);
+    return !trace.empty();
+}
+
+// the headers of a browser, so that the parser sees the bytes it sees
+// on the bench
+static std::string Request(const std::string &target) {
+    std::string r = "GET " + target + " HTTP/1.1\r\n"
+        "Host: 192.168.0.20\r\n"
+        "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:115.0) Gecko/20100101 Firefox/115.0\r\n"
+        "Accept: */*\r\n"
+        "Accept-Language: en-US,en;q=0.5\r\n"
+        "Accept-Encoding: gzip, deflate\r\n"
+        "Referer: http://192.168.0.20/\r\n";
+
+    r += keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    return r + "\r\n";
+}
+
+// the value of header name in the head of an answer, "" if none
+static std::string Header(const std::string &head, const char *name) {
+    std::string key = std::string("\r\n") + name + ": ";
+    size_t p = head.find(key);
+
+    if (p == std::string::npos) {
+        return "";
+    }
+    p += key.size();
+    return head.substr(p, head.find("\r\n", p) - p);
+}
+
+// the files an HTML page refers to by src= and href=
+static void PageFiles(const std::string &body, std::vector<std::string> &files) {
+    static const char *attrs[] = {"src=\"", "href=\""};
+
+    for (const char *attr : attrs) {
+        for (size_t p = body.find(attr); p != std::string::npos; p = body.find(attr, p)) {
+            p += strlen(attr);
+            std::string url = body.substr(p, body.find('"', p) - p);
+
+            if (url.empty() || url.find(':') != std::string::npos ||
+                    url.compare(0, 2, "//") == 0 || url[0] == '#') {
+                continue;
+            }
+            files.push_back(url[0] == '/' ? url : "/" + url);
+        }
+    }
+}
+
+static void Finish(Client &c, boolean ok) {
+    if (ok) {
+        requests++;
+        latencyNs.push_back(c.hostNs);
+        responseUs.push_back(MockNow() - c.sentUs);
+    }
+    else {
+        failed++;
+    }
+    c.busy = false;
+    c.in.clear();
+}
+
+// true once the whole answer to the request of c has arrived; closed
+// tells that the server has closed the connection
+static boolean Complete(Client &c, boolean closed) {
+    size_t end = c.in.find("\r\n\r\n");
+
+    if (end == std::string::npos) {
+        return false;
+    }
+    std::string head = c.in.substr(0, end + 2);
+    std::string length = Header(head, "Content-Length");
+    size_t body = end + 4;
+
+    if (!length.empty() && c.in.size() < body + atol(length.c_str())) {
+        return false;
+    }
+    if (length.empty() && head.compare(9, 3, "200") == 0 && !closed) {
+        return false;       // ends with the connection
+    }
+    c.closing = Header(head, "Connection") == "close";
+    if (c.target == "/" && head.compare(9, 3, "200") == 0) {
+        PageFiles(c.in.substr(body), c.files);
+    }
+    return true;
+}
+
+static void ServeClient(Client &c) {
+    unsigned long long now = MockNow();
+
+    if (c.sock >= 0) {
+        boolean closed = !MockOpen(c.sock);
+
+        MockReceive(c.sock, c.in);
+        if (c.busy && Complete(c, closed)) {
+            Finish(c, true);
+        }
+        if (closed) {
+            if (c.busy) {
+                Finish(c, false);
+            }
+            MockClose(c.sock);
+            c.sock = -1;
+            c.closing = false;
+        }
+    }
+    // like a browser, waits for the server to close a connection it
+    // announced to close
+    if (c.busy || (c.sock >= 0 && c.closing)) {
+        return;
+    }
+    if (c.files.empty() &&
+            (c.next == trace.size() ||
+             (!backToBack && c.startUs + trace[c.next].ms * 1000ULL > now))) {
+        return;
+    }
+    if (c.sock < 0) {
+        if ((c.sock = MockConnect()) < 0) {
+            connectWaits++;
+            return;
+        }
+        connections++;
+    }
+    if (!c.files.empty()) {
+        c.target = c.files.front();
+        c.files.erase(c.files.begin());
+    }
+    else {
+        c.target = trace[c.next++].target;
+    }
+    std::string r = Request(c.target);
+
+    MockSend(c.sock, r.data(), r.size());
+    c.busy = true;
+    c.hostNs = 0;
+    c.sentUs = now;
+}
+
+// a WebSocket held open like the one of the page, reopened after
+// REOPEN_MS when the server has closed it
+static void ServeSocket(Socket &s) {
+    if (s.sock >= 0) {
+        MockReceive(s.sock, s.in);
+        if (!s.open && s.in.find("\r\n\r\n") != std::string::npos) {
+            s.open = s.in.compare(9, 3, "101") == 0;
+            wsOpens += s.open;
+        }
+        if (MockOpen(s.sock)) {
+            return;
+        }
+        MockClose(s.sock);
+        s.sock = -1;
+        s.open = false;
+        s.reopenUs = MockNow() + REOPEN_MS * 1000ULL;
+    }
+    if (MockNow() < s.reopenUs || (s.sock = MockConnect()) < 0) {
+        return;
+    }
+    std::string r = "GET /ws HTTP/1.1\r\n"
+        "Host: 192.168.0.20\r\n"
+        "Upgrade: websocket\r\n"
+        "Connection: Upgrade\r\n"
+        "Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+        "Sec-WebSocket-Version: 13\r\n\r\n";
+
+    MockSend(s.sock, r.data(), r.size());
+    s.in.clear();
+}
+
+// clients that send the page request and a run of polls, more answers
+// than their socket holds, and never read
+static void Stall(int n) {
+    std::string page = Request("/");
+    std::string poll = Request(trace[0].target);
+
+    for (int i = 0; i < n; i++) {
+        int sock = MockConnect();
+
+        if (sock < 0) {
+            break;
+        }
+        MockStall(sock, true);
+        MockSend(sock, page.data(), page.size());
+        for (int j = 0; j < 10; j++) {
+            MockSend(sock, poll.data(), poll.size());
+        }
+    }
+}
+
+static unsigned long long Percentile(std::vector<unsigned long long> v, int p) {
+    if (v.empty()) {
+        return 0;
+    }
+    std::sort(v.begin(), v.end());
+    return v[(v.size() - 1) * p / 100];
+}
+
+static void Report(int numClients, int numSockets, int stalled, unsigned long rtt) {
+    double busyS = busyNs / 1e9;
+    unsigned long n = requests ? requests : 1;
+
+    printf("clients %d, websockets %d, stalled %d, keep-alive %s, rtt %lu ms%s\n",
+           numClients, numSockets, stalled, keepAlive ? "on" : "off", rtt,
+           backToBack ? ", back to back" : "");
+    printf("requests %lu, failed %lu, simulated %.1f s\n",
+           requests, failed, MockNow() / 1e6);
+    printf("requests/s             %.0f host, %.0f simulated\n",
+           busyS > 0 ? requests / busyS : 0.0, busyUs ? requests / (busyUs / 1e6) : 0.0);
+    printf("handler latency us     p50 %.2f  p99 %.2f\n",
+           Percentile(latencyNs, 50) / 1e3, Percentile(latencyNs, 99) / 1e3);
+    printf("response time ms       p50 %.1f  p99 %.1f\n",
+           Percentile(responseUs, 50) / 1e3, Percentile(responseUs, 99) / 1e3);
+    printf("loop() passes          busy %lu (%.2f us)  idle %lu (%.2f us)\n",
+           busyPasses, busyPasses ? busyNs / 1e3 / busyPasses : 0.0,
+           idlePasses, idlePasses ? idleNs / 1e3 / idlePasses : 0.0);
+    printf("connections            %lu, passes waiting for a socket %lu\n",
+           connections, connectWaits);
+    printf("websockets opened      %lu\n", wsOpens);
+    printf("dropped                idle %u  header %u  drain %u  reserve %u\n",
+           drops[0], drops[1], drops[2], drops[3]);
+    printf("bytes read/written     %lu / %lu  (%.0f / %.0f per request)\n",
+           mock.bytesRead, mock.bytesWritten,
+           (double)mock.bytesRead / n, (double)mock.bytesWritten / n);
+    printf("blocked writes         %lu, lost bytes %lu\n",
+           mock.blockedWrites, mock.lostBytes);
+    printf("stop() wait ms         total %.1f  max %.1f\n",
+           mock.stopWaitUs / 1e3, mock.stopWaitMaxUs / 1e3);
+    printf("%-22s %10s %12s\n", "calls", "total", "per request");
+
+    const struct {
+        const char *name;
+        unsigned long count;
+    } calls[] = {
+        {"accept", mock.accept},
+        {"connected", mock.connected},
+        {"available", mock.available},
+        {"read", mock.read},
+        {"write", mock.write},
+        {"availableForWrite", mock.availableForWrite},
+        {"stop", mock.stop},
+        {"setConnectionTimeout", mock.setConnectionTimeout},
+        {"SD.open", mock.sdOpen},
+        {"File.read", mock.sdRead},
+        {"digitalWrite", mock.digitalWrite},
+        {"getTemp", mock.getTemp},
+        {"millis", mock.millis},
+    };
+    for (const auto &call : calls) {
+        printf("  %-20s %10lu %12.2f\n", call.name, call.count, (double)call.count / n);
+    }
+}
+
+int main(int argc, char **argv) {
+    const char *tracePath = "traces/dashboard.txt";
+    const char *card = "../build/sd";
+    int numClients = 1;
+    int numSockets = 0;
+    int stalled = 0;
+    unsigned long rtt = 20;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "c:w:s:kbr:d:")) != -1) {
+        switch (opt) {
+        case 'c': numClients = atoi(optarg); break;
+        case 'w': numSockets = atoi(optarg); break;
+        case 's': stalled = atoi(optarg); break;
+        case 'k': keepAlive = false; break;
+        case 'b': backToBack = true; break;
+        case 'r': rtt = atol(optarg); break;
+        case 'd': card = optarg; break;
+        default:
+            fprintf(stderr, "usage: %s [-c clients] [-w websockets] [-s stalled] [-k] [-b] "
+                    "[-r rtt_ms] [-d card_dir] [trace]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (optind < argc) {
+        tracePath = argv[optind];
+    }
+    if (!LoadTrace(tracePath)) {
+        fprintf(stderr, "can't read trace %s\n", tracePath);
+        return 1;
+    }
+    MockCard(card);
+    MockRtt(rtt);
+    setup();
+
+    Stall(stalled);
+    sockets.resize(numSockets, Socket{-1, 0, "", false});
+    for (int i = 0; i < numClients; i++) {
+        Client c = Client();
+
+        c.sock = -1;
+        c.startUs = backToBack ? 0 : i * STAGGER_MS * 1000ULL;
+        c.files.push_back("/");
+        clients.push_back(c);
+    }
+    unsigned long long endUs = backToBack ? 0 : (numClients - 1) * STAGGER_MS * 1000ULL +
+        (trace.back().ms + TAIL_MS) * 1000ULL;
+
+    for (;;) {
+        boolean busy = false;
+        boolean done = true;
+
+        for (Socket &s : sockets) {
+            ServeSocket(s);
+        }
+        for (Client &c : clients) {
+            ServeClient(c);
+            busy |= c.busy || (c.sock >= 0 && c.closing);
+            done &= !c.busy && c.files.empty() && c.next == trace.size();
+        }
+        if (done && MockNow() >= endUs) {
+            break;
+        }
+
+        unsigned long long now = MockNow();
+        unsigned long long start = HostNs();
+        loop();
+        unsigned long long ns = HostNs() - start;
+
+        if (busy) {
+            busyNs += ns;
+            busyPasses++;
+            for (Client &c : clients) {
+                c.hostNs += c.busy ? ns : 0;
+            }
+            MockAdvance(PASS_US);
+            busyUs += MockNow() - now;
+        }
+        else {
+            idleNs += ns;
+            idlePasses++;
+            MockAdvance(IDLE_US);
+        }
+    }
+    Report(numClients, numSockets, stalled, rtt);
+    return 0;
+}
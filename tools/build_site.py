@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+"""Builds the contents of the SD card from website_on_SD.
+
+The pages (.htm) keep their names. Every other file is renamed to the
+first 8 hex digits of the SHA-1 of its contents, keeping its extension,
+and the references to it in the pages are changed to the new name. The
+web server lets browsers cache such files for a year, since a changed
+file always gets a new name.
+
+Every file is written to the output directory, together with a gzip
+compressed sibling when that is smaller. The card is FAT16 and the SD
+library only knows 8.3 names, so the sibling of index.htm is index.htz:
+the name with its last character replaced by 'z'. The web server sends
+the sibling with Content-Encoding: gzip to clients that accept it.
+
+The same files, compressed when that is smaller, are also written as
+PROGMEM arrays to webserver_sketch/site_bundle.h. The web server sends
+them from flash, so the page works without the card; the card is only
+read for files that are not in the bundle, and for clients that do not
+accept gzip.
+
+The pages may hold placeholders of the live state, {{RELAY1}} to
+{{RELAY5}} and {{TEMP}}. Each becomes a run of marker bytes as wide as
+its value, which the web server replaces while it sends the page, so
+the page shows the state without waiting for a request of its own.
+Such a page is never compressed: the server could not replace the
+markers in compressed data.
+
+Before that the files are made smaller by optimize.py: references to
+other hosts (fonts, CDN scripts) and unused style rules are dropped,
+and comments and white space are removed. The build fails when the
+files of the bundle together take more than the budget, so that the
+page cannot grow unnoticed. It also fails when a file name has the same
+path hash as another file or a route of the sketch.
+
+Usage: tools/build_site.py [--budget bytes] [source directory] [output directory]
+Copy the output directory (build/sd by default) to the root of the card,
+then build and upload the sketch.
+"""
+
+import argparse
+import gzip
+import hashlib
+import os
+import re
+import shutil
+import sys
+
+from optimize import minify_css, minify_html, minify_js
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+BUNDLE = os.path.join(ROOT, "webserver_sketch", "site_bundle.h")
+SKETCH = os.path.join(ROOT, "webserver_sketch", "webserver_sketch.ino")
+
+# 8.3 names, as the SD library opens them
+NAME_8_3 = re.compile(r"^[A-Za-z0-9_~-]{1,8}(\.[A-Za-z0-9_~-]{1,3})?$")
+
+# bytes of the bundle, as sent to a browser that accepts gzip
+BUDGET = 4608
+
+# state placeholders, the marker bytes and widths of FILL_ in
+# webserver_sketch.ino
+PLACEHOLDER = re.compile(rb"\{\{(RELAY([1-5])|TEMP)\}\}")
+FILL_RELAY = 1                  # RELAY1, RELAY2 is FILL_RELAY + 1 ...
+FILL_RELAY_W = 3                # "ON " or "OFF"
+FILL_TEMP = 6
+FILL_TEMP_W = 4                 # degrees, padded with spaces
+
+# route paths of the sketch, constexpr char PATH_...[] PROGMEM = "/..."
+ROUTE_PATH = re.compile(r'constexpr char PATH_\w+\[\] PROGMEM = "([^"]*)";')
+
+
+def path_hash(path):
+    """PathHash() of webserver_sketch.ino."""
+    h = 5381
+    for c in path.encode():
+        h = ((h * 33) & 0xFFFF) ^ c
+    return h
+
+
+def check_hashes(names):
+    """Fails if two paths served have the same PathHash().
+
+    The sketch finds routes, bundled files and files of the card by
+    their 16 bit path hash; it confirms a route or bundled file with a
+    string compare, but the file cache keeps only hashes, lowercased as
+    FileScan() makes them. names are the files of the card.
+    """
+    with open(SKETCH) as f:
+        paths = set(ROUTE_PATH.findall(f.read()))
+    paths.update("/" + name for name in names)
+    paths.update("/" + name.lower() for name in names)
+    seen = {}
+    for path in sorted(paths):
+        other = seen.setdefault(path_hash(path), path)
+        if other != path:
+            sys.exit("%s: path hash 0x%04x collides with %s, rename it"
+                     % (path, path_hash(path), other))
+
+
+def gz_name(name):
+    return name[:-1] + "z"
+
+
+def hashed_name(name, data):
+    ext = os.path.splitext(name)[1]
+    return hashlib.sha1(data).hexdigest()[:8] + ext
+
+
+def compress(data):
+    # mtime 0 keeps the output the same for the same input
+    return gzip.compress(data, compresslevel=9, mtime=0)
+
+
+def fill_marker(match):
+    if match.group(2):
+        return bytes([FILL_RELAY + int(match.group(2)) - 1]) * FILL_RELAY_W
+    return bytes([FILL_TEMP]) * FILL_TEMP_W
+
+
+def minify(files):
+    for name in files:
+        if name.endswith(".htm"):
+            files[name] = minify_html(files[name])
+        elif name.endswith(".js"):
+            files[name] = minify_js(files[name])
+    pages = [data for name, data in files.items() if name.endswith((".htm", ".js"))]
+    for name in files:
+        if name.endswith(".css"):
+            files[name] = minify_css(files[name], pages)
+
+
+def build(src, out, budget):
+    names = sorted(n for n in os.listdir(src)
+                   if os.path.isfile(os.path.join(src, n)))
+    for name in names:
+        if not NAME_8_3.match(name):
+            sys.exit("%s: not an 8.3 file name" % name)
+        if gz_name(name) in names:
+            sys.exit("%s: name of the compressed sibling of %s is taken"
+                     % (gz_name(name), name))
+
+    files = {}
+    for name in names:
+        with open(os.path.join(src, name), "rb") as f:
+            files[name] = f.read()
+    before = sum(len(data) for data in files.values())
+    minify(files)
+    print("minified %d bytes to %d bytes"
+          % (before, sum(len(data) for data in files.values())))
+
+    templates = set()
+    for name in names:
+        if name.endswith(".htm") and PLACEHOLDER.search(files[name]):
+            files[name] = PLACEHOLDER.sub(fill_marker, files[name])
+            templates.add(name)
+
+    # assets get content hash names, the pages refer to them by those
+    renamed = {}
+    for name in names:
+        if not name.endswith(".htm"):
+            renamed[name] = hashed_name(name, files[name])
+    for name in names:
+        if name.endswith(".htm"):
+            for old, new in renamed.items():
+                files[name] = re.sub(rb'(["\'])' + re.escape(old.encode()) + rb'\1',
+                                     lambda m: m.group(1) + new.encode() + m.group(1),
+                                     files[name])
+
+    check_hashes([renamed.get(name, name) for name in names] +
+                 [gz_name(renamed.get(name, name)) for name in names])
+
+    if os.path.isdir(out):
+        shutil.rmtree(out)
+    os.makedirs(out)
+
+    bundle = []
+    for name in names:
+        data = files[name]
+        if name in renamed:
+            print("%-12s -> %s" % (name, renamed[name]))
+            name = renamed[name]
+        with open(os.path.join(out, name), "wb") as f:
+            f.write(data)
+
+        packed = compress(data)
+        if name in templates:
+            print("%-12s %6d bytes, state placeholders, not compressed"
+                  % (name, len(data)))
+            bundle.append((name, data, False))
+        elif len(packed) < len(data):
+            with open(os.path.join(out, gz_name(name)), "wb") as f:
+                f.write(packed)
+            print("%-12s %6d bytes, %-12s %6d bytes (%.1fx)"
+                  % (name, len(data), gz_name(name), len(packed),
+                     float(len(data)) / len(packed)))
+            bundle.append((name, packed, True))
+        else:
+            print("%-12s %6d bytes, not compressed" % (name, len(data)))
+            bundle.append((name, data, False))
+
+    # checked before the bundle is written, the sketch keeps the last good one
+    size = sum(len(data) for name, data, packed in bundle)
+    if size > budget:
+        sys.exit("%d bytes, over the budget of %d bytes" % (size, budget))
+    print("%d bytes of %d bytes budget" % (size, budget))
+
+    write_bundle(bundle)
+
+
+def write_bundle(bundle):
+    lines = [
+        "// generated by tools/build_site.py from website_on_SD, do not edit",
+        "// files sent from flash, see BundleFile in webserver_sketch.ino",
+        "",
+    ]
+    for i, (name, data, packed) in enumerate(bundle):
+        lines.append("constexpr char BUNDLE_PATH_%d[] PROGMEM = \"/%s\";" % (i, name))
+        lines.append("const byte BUNDLE_DATA_%d[] PROGMEM = {" % i)
+        for j in range(0, len(data), 16):
+            lines.append("    " + " ".join("0x%02x," % b for b in data[j:j + 16]))
+        lines.append("};")
+        lines.append("")
+
+    lines.append("constexpr BundleFile BUNDLE[] PROGMEM = {")
+    for i, (name, data, packed) in enumerate(bundle):
+        etag = int(hashlib.sha1(data).hexdigest()[:8], 16)
+        lines.append("    { PathHash(BUNDLE_PATH_%d), BUNDLE_PATH_%d, BUNDLE_DATA_%d, %d, %s, 0x%08xUL },"
+                     % (i, i, i, len(data), "true" if packed else "false", etag))
+    lines.append("};")
+    lines.append("")
+
+    with open(BUNDLE, "w") as f:
+        f.write("\n".join(lines))
+    print("%s: %d files, %d bytes of flash"
+          % (os.path.relpath(BUNDLE, ROOT), len(bundle),
+             sum(len(data) for name, data, packed in bundle)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Builds the contents of the SD card.")
+    parser.add_argument("--budget", type=int, default=BUDGET,
+                        help="most bytes the bundled files may take (default %d)" % BUDGET)
+    parser.add_argument("src", nargs="?", default=os.path.join(ROOT, "website_on_SD"))
+    parser.add_argument("out", nargs="?", default=os.path.join(ROOT, "build", "sd"))
+    args = parser.parse_args()
+    build(args.src, args.out, args.budget)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,146 @@
+"""Size optimizations of the web site files, used by build_site.py.
+
+Only what the site in website_on_SD needs is handled; the input is
+trusted, these are not general purpose minifiers.
+
+- Pages: references to other hosts are dropped (the wall panels are on
+  a LAN without internet, such a request only stalls the page), as are
+  comments and the white space between lines.
+- Style sheets: @import is dropped, and so are @media print blocks and
+  every rule whose selectors name a class, id or element that no page
+  or script uses.
+- Scripts: comments, indentation and blank lines are dropped.
+"""
+
+import re
+
+EXTERNAL_LINK = re.compile(rb'<link\b[^>]*\bhref="(?:https?:)?//[^"]*"[^>]*>\s*', re.I)
+EXTERNAL_SCRIPT = re.compile(rb'<script\b[^>]*\bsrc="(?:https?:)?//[^"]*"[^>]*>\s*</script>\s*', re.I)
+HTML_COMMENT = re.compile(rb'<!--.*?-->\s*', re.S)
+LINE_BREAK = re.compile(rb'>\s*\n\s*<')
+SPACE = re.compile(rb'\s+')
+
+
+def minify_html(data):
+    data = EXTERNAL_LINK.sub(b'', data)
+    data = EXTERNAL_SCRIPT.sub(b'', data)
+    data = HTML_COMMENT.sub(b'', data)
+    data = LINE_BREAK.sub(b'><', data)
+    return SPACE.sub(b' ', data).strip() + b'\n'
+
+
+def minify_js(data):
+    """Drops comments, indentation and blank lines, the line breaks are
+    kept so that automatic semicolon insertion is not affected."""
+    text = data.decode()
+    out = []
+    i = 0
+    quote = None
+    while i < len(text):
+        c = text[i]
+        if quote:
+            out.append(c)
+            if c == '\\':
+                out.append(text[i + 1])
+                i += 1
+            elif c == quote:
+                quote = None
+        elif c in '"\'':
+            quote = c
+            out.append(c)
+        elif text.startswith('//', i):
+            while i < len(text) and text[i] != '\n':
+                i += 1
+            continue
+        elif text.startswith('/*', i):
+            i = text.index('*/', i) + 2
+            continue
+        else:
+            out.append(c)
+        i += 1
+    lines = (line.strip() for line in ''.join(out).split('\n'))
+    return ('\n'.join(line for line in lines if line) + '\n').encode()
+
+
+def used_names(pages):
+    """Classes, ids and element names used by the pages and scripts."""
+    names = set()
+    for data in pages:
+        text = data.decode()
+        names.update('.' + c for attr in re.findall(r'class="([^"]*)"', text)
+                     for c in attr.split())
+        names.update('#' + i for i in re.findall(r'id="([^"]*)"', text))
+        names.update(t.lower() for t in re.findall(r'<([A-Za-z][A-Za-z0-9]*)', text))
+        # ids and classes the scripts refer to
+        names.update('#' + i for i in re.findall(r'getElementById\("([^"]*)"\)', text))
+        names.update('.' + c for c in re.findall(r'className\s*=\s*"([^"]*)"', text))
+    return names
+
+
+def selector_used(selector, names):
+    # attribute selectors, pseudo classes and elements never hide a name
+    plain = re.sub(r'\[[^\]]*\]|::?[\w-]+(\([^)]*\))?', ' ', selector)
+    for token in re.findall(r'[.#]?[\w-]+', plain):
+        if token[0] in '.#':
+            if token not in names:
+                return False
+        elif not token[0].isdigit() and token.lower() not in names:
+            return False
+    return True
+
+
+def split_blocks(css):
+    """Splits css into (prelude, body) pairs at the top level, body is
+    None for statements such as @import."""
+    items = []
+    i = 0
+    while i < len(css):
+        brace = css.find('{', i)
+        semi = css.find(';', i)
+        if brace < 0:
+            break
+        if css[i] == '@' and 0 <= semi < brace:
+            items.append((css[i:semi].strip(), None))
+            i = semi + 1
+            continue
+        depth = 0
+        j = brace
+        while True:
+            if css[j] == '{':
+                depth += 1
+            elif css[j] == '}':
+                depth -= 1
+                if depth == 0:
+                    break
+            j += 1
+        items.append((css[i:brace].strip(), css[brace + 1:j]))
+        i = j + 1
+    return items
+
+
+def prune_css(css, names):
+    out = []
+    for prelude, body in split_blocks(css):
+        if body is None:
+            if not prelude.startswith('@import'):
+                out.append(prelude + ';')
+        elif prelude.startswith('@media'):
+            if re.match(r'@media\s+print\b', prelude):
+                continue
+            inner = prune_css(body, names)
+            if inner:
+                out.append(prelude + '{' + inner + '}')
+        elif prelude.startswith('@'):
+            out.append(prelude + '{' + body + '}')
+        else:
+            selectors = [s.strip() for s in prelude.split(',')]
+            kept = [s for s in selectors if selector_used(s, names)]
+            if kept:
+                out.append(','.join(kept) + '{' + body.strip() + '}')
+    return ''.join(out)
+
+
+def minify_css(data, pages):
+    css = re.sub(r'/\*.*?\*/', '', data.decode(), flags=re.S)
+    css = re.sub(r'\s+', ' ', css)
+    return (prune_css(css, used_names(pages)) + '\n').encode()
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+"""Reports the static SRAM use of the sketch as built for the Uno.
+
+The sketch is compiled for arduino:avr:uno with arduino-cli, and the
+.data and .bss sections of the ELF are read with avr-size. Their sum is
+the "Global variables use" figure of the IDE; what is left of the 2048
+bytes is shared by the heap (the SD library allocates from it on every
+open) and the stack. The report fails when the sum is over the limit,
+75% of SRAM by default, where the IDE warns of low memory.
+
+With --base the sketch of a git revision is built too and the bytes
+reclaimed are reported, e.g. --base e9b9507 for the sketch before the
+rework.
+
+Needs arduino-cli with the arduino:avr core and the Ethernet (2.0 or
+later), SD and Thermistor libraries installed. avr-size is taken from
+the PATH, or from the avr-gcc that arduino-cli installed.
+
+Usage: tools/sram_report.py [--base revision] [--max bytes] [--elf file]
+"""
+
+import argparse
+import glob
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SKETCH = "webserver_sketch"
+FQBN = "arduino:avr:uno"
+
+SRAM = 2048
+# the IDE warns of low memory over 75% of SRAM
+LIMIT = SRAM * 3 // 4
+
+SECTION = re.compile(r"^\.(data|bss)\s+(\d+)", re.M)
+
+
+def avr_size():
+    path = shutil.which("avr-size")
+    if path:
+        return path
+    found = sorted(glob.glob(os.path.expanduser(
+        "~/.arduino15/packages/arduino/tools/avr-gcc/*/bin/avr-size")))
+    if not found:
+        sys.exit("avr-size not found, install the arduino:avr core")
+    return found[-1]
+
+
+def sections(elf):
+    """Bytes of .data and .bss of elf."""
+    out = subprocess.run([avr_size(), "-A", elf], check=True,
+                         stdout=subprocess.PIPE, universal_newlines=True).stdout
+    sizes = {name: int(size) for name, size in SECTION.findall(out)}
+    return sizes.get("data", 0), sizes.get("bss", 0)
+
+
+def compile_sketch(sketch_dir, build_dir):
+    """Compiles the sketch in sketch_dir, returns the path of its ELF."""
+    if not shutil.which("arduino-cli"):
+        sys.exit("arduino-cli not found, or give the ELF with --elf")
+    subprocess.run(["arduino-cli", "compile", "--fqbn", FQBN,
+                    "--output-dir", build_dir, sketch_dir], check=True,
+                   stdout=subprocess.DEVNULL)
+    return os.path.join(build_dir, SKETCH + ".ino.elf")
+
+
+def checkout(revision, work):
+    """Writes the sketch directory of revision to work, returns its path."""
+    sketch_dir = os.path.join(work, SKETCH)
+    os.makedirs(sketch_dir)
+    names = subprocess.run(["git", "-C", ROOT, "ls-tree", "--name-only",
+                            revision, SKETCH + "/"], check=True,
+                           stdout=subprocess.PIPE,
+                           universal_newlines=True).stdout.split()
+    for name in names:
+        data = subprocess.run(["git", "-C", ROOT, "show", revision + ":" + name],
+                              check=True, stdout=subprocess.PIPE).stdout
+        with open(os.path.join(work, name), "wb") as f:
+            f.write(data)
+    return sketch_dir
+
+
+def report(name, data, bss):
+    print("%-10s .data %5d  .bss %5d  static %5d  left %5d of %d bytes"
+          % (name, data, bss, data + bss, SRAM - data - bss, SRAM))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Reports the static SRAM use of the sketch.")
+    parser.add_argument("--base", help="git revision to compare against")
+    parser.add_argument("--max", type=int, default=LIMIT,
+                        help="most bytes of .data and .bss (default %d)" % LIMIT)
+    parser.add_argument("--elf", help="ELF of the sketch, built already")
+    args = parser.parse_args()
+
+    work = tempfile.mkdtemp()
+    try:
+        elf = args.elf or compile_sketch(os.path.join(ROOT, SKETCH),
+                                         os.path.join(work, "build"))
+        data, bss = sections(elf)
+        if args.base:
+            base_elf = compile_sketch(checkout(args.base, os.path.join(work, "base")),
+                                      os.path.join(work, "base-build"))
+            base_data, base_bss = sections(base_elf)
+            report(args.base, base_data, base_bss)
+        report("sketch", data, bss)
+        if args.base:
+            print("reclaimed %d bytes" % (base_data + base_bss - data - bss))
+    finally:
+        shutil.rmtree(work)
+
+    if data + bss > args.max:
+        sys.exit("%d bytes of static SRAM, over the limit of %d bytes"
+                 % (data + bss, args.max))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,289 @@
+// generated by tools/build_site.py from website_on_SD, do not edit
+// files sent from flash, see BundleFile in webserver_sketch.ino
+
+constexpr char BUNDLE_PATH_0[] PROGMEM = "/206f804f.js";
+const byte BUNDLE_DATA_0[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x95, 0x55, 0x6d, 0x6f, 0xda, 0x30,
+    0x10, 0xfe, 0xce, 0xaf, 0xf0, 0xf2, 0xa1, 0x75, 0xd4, 0x2e, 0x84, 0x69, 0x9b, 0xba, 0x52, 0x54,
+    0xb5, 0x1b, 0x7d, 0x99, 0xda, 0x22, 0x15, 0xba, 0x17, 0x55, 0x6c, 0x72, 0xe1, 0xa0, 0xd9, 0xc0,
+    0x66, 0xb6, 0x43, 0x8a, 0x3a, 0xfe, 0xfb, 0xee, 0xe2, 0x90, 0x04, 0x0a, 0xeb, 0xf6, 0x05, 0x92,
+    0xf3, 0xdd, 0x73, 0x77, 0xcf, 0x3d, 0xbe, 0x4c, 0x85, 0x66, 0x77, 0x56, 0x7e, 0x37, 0x56, 0x58,
+    0x60, 0x0d, 0x76, 0x1b, 0x76, 0xeb, 0x95, 0x29, 0x1a, 0xa7, 0xa0, 0x4d, 0xa4, 0x24, 0x9a, 0x42,
+    0x67, 0x30, 0xaa, 0xf7, 0x13, 0x2c, 0xbe, 0xcb, 0x78, 0x34, 0xaa, 0x57, 0x06, 0xb1, 0xec, 0x59,
+    0x72, 0x68, 0xdf, 0xab, 0xa4, 0x4d, 0xd1, 0x3c, 0xc5, 0xf0, 0xd9, 0x63, 0xea, 0x8e, 0xa0, 0xc6,
+    0x6a, 0x74, 0xf7, 0x3c, 0x74, 0x56, 0x9a, 0x71, 0xb2, 0x46, 0x29, 0x1e, 0xfe, 0x1d, 0xb0, 0x37,
+    0xf8, 0xb7, 0xb3, 0x43, 0xee, 0x85, 0xeb, 0x75, 0xf3, 0xe2, 0xe8, 0xab, 0xc7, 0x76, 0x18, 0x8f,
+    0xf0, 0xa7, 0xe6, 0xd7, 0x2b, 0xd1, 0x80, 0x39, 0xdc, 0x40, 0xc3, 0x48, 0xcc, 0x0c, 0xdb, 0x62,
+    0xbc, 0xc6, 0x0e, 0x0e, 0x58, 0xe4, 0x53, 0x68, 0x5f, 0xf5, 0xe2, 0x31, 0x48, 0x1b, 0x0c, 0xc1,
+    0x36, 0x47, 0x40, 0x8f, 0xc7, 0xb3, 0xf3, 0x3e, 0x77, 0x90, 0x7e, 0x10, 0x49, 0x09, 0xfa, 0xac,
+    0x73, 0x79, 0x41, 0xe8, 0xad, 0x2b, 0x2c, 0x25, 0x6f, 0xf6, 0x36, 0xea, 0xa2, 0xb1, 0x56, 0xaf,
+    0xcc, 0x2b, 0x30, 0x32, 0xf0, 0xdf, 0x60, 0x27, 0x27, 0x4f, 0xd1, 0x42, 0x42, 0x9b, 0x6f, 0x04,
+    0xf2, 0x7a, 0x98, 0x29, 0x8a, 0x8d, 0xb7, 0x8c, 0xe5, 0xfa, 0xb3, 0x30, 0x9e, 0x50, 0x78, 0x41,
+    0xac, 0x15, 0xda, 0xde, 0x4c, 0xfa, 0x78, 0x68, 0x38, 0x35, 0xfb, 0x2c, 0x8b, 0xe5, 0x52, 0xf8,
+    0xc6, 0x22, 0x56, 0x49, 0x2e, 0x15, 0x83, 0x4f, 0x7d, 0x78, 0x68, 0x0d, 0x38, 0x71, 0xe5, 0xb3,
+    0x06, 0xa6, 0xf1, 0xd9, 0x21, 0xab, 0xb1, 0x7d, 0xd7, 0x1a, 0x4d, 0x23, 0x41, 0x1f, 0x95, 0x04,
+    0x9f, 0xe1, 0xae, 0xed, 0x14, 0xb1, 0xb5, 0xc5, 0x32, 0xdb, 0x07, 0x61, 0xc5, 0xa7, 0x08, 0x12,
+    0x2a, 0xa7, 0x35, 0x01, 0xe9, 0x1c, 0xb8, 0x9f, 0x73, 0x5c, 0x8a, 0x6f, 0x4e, 0xb1, 0xa0, 0xb6,
+    0x8a, 0x75, 0x2f, 0x97, 0x0c, 0x90, 0xc9, 0x90, 0xc2, 0x20, 0x61, 0xa5, 0x73, 0xee, 0xb9, 0x13,
+    0x0f, 0x81, 0xdc, 0x53, 0xa0, 0xe4, 0x18, 0x8c, 0x11, 0x43, 0x92, 0xec, 0x82, 0x30, 0x9e, 0x02,
+    0x15, 0x72, 0xfc, 0xd8, 0x6e, 0x5d, 0x05, 0x13, 0xa1, 0x0d, 0x70, 0x08, 0x90, 0x45, 0xe1, 0xbb,
+    0x42, 0x16, 0x08, 0xa0, 0xb5, 0xd2, 0xe5, 0x78, 0x0a, 0xa7, 0x0a, 0x33, 0x0f, 0x0d, 0xa2, 0x3f,
+    0x6b, 0xbb, 0x7b, 0xd1, 0x28, 0xd7, 0x13, 0xbc, 0xbf, 0x68, 0xb5, 0x9b, 0x1f, 0xc8, 0xfd, 0x14,
+    0xec, 0x91, 0xee, 0xc7, 0x91, 0x54, 0xe7, 0x2d, 0xd7, 0xe7, 0xbc, 0xd0, 0xd3, 0xba, 0xc3, 0x7c,
+    0xba, 0x65, 0x7e, 0xb2, 0xfe, 0x93, 0x45, 0xef, 0x39, 0xb7, 0xdc, 0x4b, 0xcc, 0x7e, 0xb5, 0x4a,
+    0xc3, 0x1a, 0xa9, 0x9e, 0xa0, 0xc0, 0xe0, 0x5e, 0x19, 0x8b, 0xef, 0x5e, 0x35, 0x49, 0x09, 0x49,
+    0x4c, 0x70, 0x17, 0x49, 0xa1, 0x67, 0x9d, 0xd9, 0x84, 0xd8, 0xf0, 0x84, 0xd6, 0x62, 0x76, 0x17,
+    0x0f, 0x06, 0xa0, 0xbd, 0xf4, 0x58, 0x49, 0x85, 0xb9, 0x56, 0x1b, 0xcd, 0xaf, 0x73, 0x62, 0xa8,
+    0xb2, 0xe4, 0x6f, 0x9c, 0x52, 0x71, 0x44, 0x60, 0x56, 0xde, 0x62, 0xcc, 0x0b, 0x5a, 0xeb, 0x25,
+    0xd2, 0x1f, 0x99, 0xbb, 0xa7, 0xfb, 0x69, 0x00, 0x69, 0xef, 0x26, 0x92, 0x76, 0x8f, 0x87, 0xfe,
+    0x2e, 0x23, 0x85, 0x17, 0xf6, 0x73, 0x69, 0x6b, 0x6f, 0x79, 0x0d, 0xcd, 0x3a, 0xc6, 0x2c, 0x73,
+    0x3f, 0x2f, 0xa3, 0x37, 0x52, 0x06, 0xd6, 0x0d, 0xe6, 0x85, 0x2b, 0x7a, 0x1d, 0xf1, 0x1a, 0x6c,
+    0xac, 0x25, 0x41, 0xac, 0xec, 0x29, 0x03, 0xb6, 0x13, 0x8d, 0x41, 0xc5, 0x96, 0x17, 0x94, 0xef,
+    0xb2, 0x57, 0x61, 0x18, 0xae, 0x8e, 0x64, 0x19, 0x33, 0xeb, 0x5b, 0xc3, 0xaf, 0x18, 0x8c, 0xcd,
+    0x5a, 0xff, 0x72, 0x79, 0x71, 0x66, 0xed, 0xe4, 0xda, 0x19, 0x5d, 0xe2, 0xf4, 0x11, 0xcb, 0x4e,
+    0xf5, 0x92, 0xde, 0xc0, 0xde, 0xbd, 0x90, 0xc3, 0xb5, 0x1d, 0xd8, 0xfb, 0x68, 0x55, 0x58, 0xaf,
+    0x97, 0xce, 0x28, 0x3e, 0x36, 0x64, 0xc7, 0x0a, 0x37, 0xea, 0x39, 0x83, 0x31, 0x13, 0x25, 0x0d,
+    0x74, 0xe0, 0xc1, 0x92, 0xb4, 0x8b, 0x8d, 0x9d, 0x3a, 0x21, 0xbf, 0xce, 0x0f, 0xb9, 0xbe, 0xce,
+    0x5c, 0xcf, 0x30, 0x33, 0x68, 0xee, 0x35, 0x3b, 0x62, 0x88, 0x4b, 0x48, 0xc3, 0x64, 0x24, 0xf0,
+    0x7e, 0x55, 0x6f, 0xbf, 0x85, 0x2f, 0xdf, 0x75, 0xab, 0xc3, 0x5d, 0xdc, 0xd6, 0x38, 0xa8, 0x1a,
+    0x51, 0xf3, 0x54, 0xbd, 0x99, 0xac, 0x97, 0xbe, 0x0c, 0x25, 0x7a, 0xb7, 0x97, 0x23, 0xb6, 0x09,
+    0x27, 0x27, 0x79, 0x5e, 0x10, 0x85, 0x53, 0xe0, 0xde, 0x69, 0xb3, 0xe3, 0x61, 0x36, 0xb7, 0xfa,
+    0x7e, 0x18, 0x25, 0x0f, 0xa7, 0x0d, 0x92, 0x79, 0x06, 0x9e, 0xa9, 0xa2, 0xa0, 0xd7, 0x80, 0xec,
+    0x73, 0x9a, 0xa8, 0x5f, 0x5f, 0x19, 0xd9, 0x71, 0x6c, 0x2d, 0x32, 0x4c, 0xeb, 0x4f, 0xc6, 0x63,
+    0x5c, 0x81, 0x7a, 0x97, 0x65, 0x2f, 0x2b, 0x33, 0x2c, 0xaf, 0xeb, 0xcc, 0x23, 0xdd, 0x94, 0xeb,
+    0xac, 0x2b, 0xab, 0x2f, 0xfd, 0x0c, 0xe5, 0xe2, 0x73, 0x4f, 0x59, 0x4d, 0xa8, 0x8a, 0x54, 0xe2,
+    0x47, 0x74, 0xef, 0xf8, 0x2d, 0xcf, 0xc9, 0xcf, 0xc0, 0x52, 0x3a, 0xd3, 0x45, 0xcb, 0x7e, 0xaf,
+    0xcd, 0x75, 0xc8, 0xc2, 0x87, 0xbd, 0x90, 0xf2, 0xf8, 0x5d, 0x7f, 0x49, 0xca, 0xff, 0xac, 0xbd,
+    0x0d, 0x94, 0x12, 0xa1, 0x25, 0x5e, 0x68, 0x6b, 0x34, 0x16, 0xb6, 0xe5, 0x22, 0x9e, 0xe1, 0xfb,
+    0x0f, 0x22, 0xe5, 0x60, 0x92, 0x26, 0x08, 0x00, 0x00,
+};
+
+constexpr char BUNDLE_PATH_1[] PROGMEM = "/index.htm";
+const byte BUNDLE_DATA_1[] PROGMEM = {
+    0x3c, 0x21, 0x44, 0x4f, 0x43, 0x54, 0x59, 0x50, 0x45, 0x20, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x3c,
+    0x68, 0x74, 0x6d, 0x6c, 0x20, 0x6c, 0x61, 0x6e, 0x67, 0x3d, 0x22, 0x65, 0x6e, 0x22, 0x3e, 0x3c,
+    0x68, 0x65, 0x61, 0x64, 0x3e, 0x3c, 0x6d, 0x65, 0x74, 0x61, 0x20, 0x63, 0x68, 0x61, 0x72, 0x73,
+    0x65, 0x74, 0x3d, 0x22, 0x75, 0x74, 0x66, 0x2d, 0x38, 0x22, 0x3e, 0x3c, 0x6d, 0x65, 0x74, 0x61,
+    0x20, 0x68, 0x74, 0x74, 0x70, 0x2d, 0x65, 0x71, 0x75, 0x69, 0x76, 0x3d, 0x22, 0x58, 0x2d, 0x55,
+    0x41, 0x2d, 0x43, 0x6f, 0x6d, 0x70, 0x61, 0x74, 0x69, 0x62, 0x6c, 0x65, 0x22, 0x20, 0x63, 0x6f,
+    0x6e, 0x74, 0x65, 0x6e, 0x74, 0x3d, 0x22, 0x49, 0x45, 0x3d, 0x65, 0x64, 0x67, 0x65, 0x22, 0x3e,
+    0x3c, 0x6d, 0x65, 0x74, 0x61, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x3d, 0x22, 0x76, 0x69, 0x65, 0x77,
+    0x70, 0x6f, 0x72, 0x74, 0x22, 0x20, 0x63, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x3d, 0x22, 0x77,
+    0x69, 0x64, 0x74, 0x68, 0x3d, 0x64, 0x65, 0x76, 0x69, 0x63, 0x65, 0x2d, 0x77, 0x69, 0x64, 0x74,
+    0x68, 0x2c, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x69, 0x61, 0x6c, 0x2d, 0x73, 0x63, 0x61, 0x6c, 0x65,
+    0x3d, 0x31, 0x20, 0x75, 0x73, 0x65, 0x72, 0x2d, 0x73, 0x63, 0x61, 0x6c, 0x61, 0x62, 0x6c, 0x65,
+    0x3d, 0x6e, 0x6f, 0x22, 0x3e, 0x3c, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e, 0x41, 0x72, 0x64, 0x75,
+    0x69, 0x6e, 0x6f, 0x20, 0x48, 0x41, 0x50, 0x3c, 0x2f, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x3e, 0x3c,
+    0x6c, 0x69, 0x6e, 0x6b, 0x20, 0x72, 0x65, 0x6c, 0x3d, 0x22, 0x69, 0x63, 0x6f, 0x6e, 0x22, 0x20,
+    0x68, 0x72, 0x65, 0x66, 0x3d, 0x22, 0x64, 0x61, 0x74, 0x61, 0x3a, 0x2c, 0x22, 0x3e, 0x3c, 0x6c,
+    0x69, 0x6e, 0x6b, 0x20, 0x72, 0x65, 0x6c, 0x3d, 0x22, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x73, 0x68,
+    0x65, 0x65, 0x74, 0x22, 0x20, 0x68, 0x72, 0x65, 0x66, 0x3d, 0x22, 0x62, 0x35, 0x30, 0x37, 0x34,
+    0x34, 0x31, 0x31, 0x2e, 0x63, 0x73, 0x73, 0x22, 0x3e, 0x3c, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74,
+    0x20, 0x73, 0x72, 0x63, 0x3d, 0x22, 0x32, 0x30, 0x36, 0x66, 0x38, 0x30, 0x34, 0x66, 0x2e, 0x6a,
+    0x73, 0x22, 0x3e, 0x3c, 0x2f, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x3e, 0x3c, 0x2f, 0x68, 0x65,
+    0x61, 0x64, 0x3e, 0x3c, 0x62, 0x6f, 0x64, 0x79, 0x20, 0x6f, 0x6e, 0x6c, 0x6f, 0x61, 0x64, 0x3d,
+    0x22, 0x53, 0x74, 0x61, 0x72, 0x74, 0x55, 0x70, 0x64, 0x61, 0x74, 0x65, 0x73, 0x28, 0x29, 0x22,
+    0x3e, 0x3c, 0x64, 0x69, 0x76, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x63, 0x6f, 0x6e,
+    0x74, 0x61, 0x69, 0x6e, 0x65, 0x72, 0x22, 0x3e, 0x3c, 0x6e, 0x61, 0x76, 0x20, 0x63, 0x6c, 0x61,
+    0x73, 0x73, 0x3d, 0x22, 0x6e, 0x61, 0x76, 0x62, 0x61, 0x72, 0x20, 0x6e, 0x61, 0x76, 0x62, 0x61,
+    0x72, 0x2d, 0x64, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x22, 0x20, 0x72, 0x6f, 0x6c, 0x65, 0x3d,
+    0x22, 0x6e, 0x61, 0x76, 0x69, 0x67, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x22, 0x3e, 0x3c, 0x64, 0x69,
+    0x76, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x74, 0x65, 0x78, 0x74, 0x2d, 0x63, 0x65,
+    0x6e, 0x74, 0x65, 0x72, 0x22, 0x3e, 0x3c, 0x68, 0x32, 0x3e, 0x41, 0x72, 0x64, 0x75, 0x69, 0x6e,
+    0x6f, 0x20, 0x48, 0x6f, 0x6d, 0x65, 0x20, 0x41, 0x75, 0x74, 0x6f, 0x6d, 0x61, 0x74, 0x69, 0x6f,
+    0x6e, 0x3c, 0x2f, 0x68, 0x32, 0x3e, 0x3c, 0x70, 0x3e, 0x3c, 0x73, 0x70, 0x61, 0x6e, 0x20, 0x69,
+    0x64, 0x3d, 0x22, 0x63, 0x65, 0x6c, 0x73, 0x69, 0x75, 0x73, 0x22, 0x3e, 0x06, 0x06, 0x06, 0x06,
+    0x3c, 0x2f, 0x73, 0x70, 0x61, 0x6e, 0x3e, 0x3c, 0x73, 0x75, 0x70, 0x3e, 0x20, 0x26, 0x64, 0x65,
+    0x67, 0x3b, 0x43, 0x3c, 0x2f, 0x73, 0x75, 0x70, 0x3e, 0x3c, 0x2f, 0x70, 0x3e, 0x3c, 0x2f, 0x64,
+    0x69, 0x76, 0x3e, 0x3c, 0x2f, 0x6e, 0x61, 0x76, 0x3e, 0x3c, 0x73, 0x65, 0x63, 0x74, 0x69, 0x6f,
+    0x6e, 0x20, 0x69, 0x64, 0x3d, 0x22, 0x63, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x22, 0x3e, 0x3c,
+    0x64, 0x69, 0x76, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x72, 0x6f, 0x77, 0x22, 0x3e,
+    0x3c, 0x64, 0x69, 0x76, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x63, 0x6f, 0x6c, 0x2d,
+    0x6d, 0x64, 0x2d, 0x6f, 0x66, 0x66, 0x73, 0x65, 0x74, 0x2d, 0x34, 0x20, 0x63, 0x6f, 0x6c, 0x2d,
+    0x6d, 0x64, 0x2d, 0x34, 0x22, 0x3e, 0x3c, 0x64, 0x69, 0x76, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73,
+    0x3d, 0x22, 0x70, 0x61, 0x6e, 0x65, 0x6c, 0x20, 0x70, 0x61, 0x6e, 0x65, 0x6c, 0x2d, 0x70, 0x72,
+    0x69, 0x6d, 0x61, 0x72, 0x79, 0x22, 0x3e, 0x3c, 0x64, 0x69, 0x76, 0x20, 0x63, 0x6c, 0x61, 0x73,
+    0x73, 0x3d, 0x22, 0x70, 0x61, 0x6e, 0x65, 0x6c, 0x2d, 0x68, 0x65, 0x61, 0x64, 0x69, 0x6e, 0x67,
+    0x22, 0x3e, 0x3c, 0x68, 0x33, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x70, 0x61, 0x6e,
+    0x65, 0x6c, 0x2d, 0x74, 0x69, 0x74, 0x6c, 0x65, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2d, 0x63, 0x65,
+    0x6e, 0x74, 0x65, 0x72, 0x22, 0x3e, 0x42, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x73, 0x3c, 0x2f, 0x68,
+    0x33, 0x3e, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x3c, 0x64, 0x69, 0x76, 0x20, 0x63, 0x6c, 0x61,
+    0x73, 0x73, 0x3d, 0x22, 0x70, 0x61, 0x6e, 0x65, 0x6c, 0x2d, 0x62, 0x6f, 0x64, 0x79, 0x22, 0x3e,
+    0x3c, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x74, 0x61,
+    0x62, 0x6c, 0x65, 0x20, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x2d, 0x73, 0x74, 0x72, 0x69, 0x70, 0x65,
+    0x64, 0x22, 0x3e, 0x3c, 0x74, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0x3c, 0x74, 0x72, 0x3e, 0x3c, 0x74,
+    0x64, 0x3e, 0x3c, 0x70, 0x3e, 0x42, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x20, 0x31, 0x3c, 0x2f, 0x70,
+    0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x62, 0x75, 0x74, 0x74, 0x6f,
+    0x6e, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x22, 0x20,
+    0x69, 0x64, 0x3d, 0x22, 0x52, 0x45, 0x4c, 0x41, 0x59, 0x31, 0x22, 0x20, 0x63, 0x6c, 0x61, 0x73,
+    0x73, 0x3d, 0x22, 0x62, 0x74, 0x6e, 0x20, 0x62, 0x74, 0x6e, 0x2d, 0x69, 0x6e, 0x66, 0x6f, 0x22,
+    0x20, 0x6f, 0x6e, 0x63, 0x6c, 0x69, 0x63, 0x6b, 0x3d, 0x22, 0x47, 0x65, 0x74, 0x42, 0x75, 0x74,
+    0x74, 0x6f, 0x6e, 0x28, 0x27, 0x52, 0x45, 0x4c, 0x41, 0x59, 0x31, 0x27, 0x2c, 0x20, 0x27, 0x30,
+    0x27, 0x29, 0x22, 0x3e, 0x01, 0x01, 0x01, 0x3c, 0x2f, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x3e,
+    0x3c, 0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x2f, 0x74, 0x72, 0x3e, 0x3c, 0x74, 0x72, 0x3e, 0x3c, 0x74,
+    0x64, 0x3e, 0x3c, 0x70, 0x3e, 0x42, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x20, 0x32, 0x3c, 0x2f, 0x70,
+    0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x62, 0x75, 0x74, 0x74, 0x6f,
+    0x6e, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x22, 0x20,
+    0x69, 0x64, 0x3d, 0x22, 0x52, 0x45, 0x4c, 0x41, 0x59, 0x32, 0x22, 0x20, 0x63, 0x6c, 0x61, 0x73,
+    0x73, 0x3d, 0x22, 0x62, 0x74, 0x6e, 0x20, 0x62, 0x74, 0x6e, 0x2d, 0x69, 0x6e, 0x66, 0x6f, 0x22,
+    0x20, 0x6f, 0x6e, 0x63, 0x6c, 0x69, 0x63, 0x6b, 0x3d, 0x22, 0x47, 0x65, 0x74, 0x42, 0x75, 0x74,
+    0x74, 0x6f, 0x6e, 0x28, 0x27, 0x52, 0x45, 0x4c, 0x41, 0x59, 0x32, 0x27, 0x2c, 0x20, 0x27, 0x31,
+    0x27, 0x29, 0x22, 0x3e, 0x02, 0x02, 0x02, 0x3c, 0x2f, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x3e,
+    0x3c, 0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x2f, 0x74, 0x72, 0x3e, 0x3c, 0x74, 0x72, 0x3e, 0x3c, 0x74,
+    0x64, 0x3e, 0x3c, 0x70, 0x3e, 0x42, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x20, 0x33, 0x3c, 0x2f, 0x70,
+    0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x62, 0x75, 0x74, 0x74, 0x6f,
+    0x6e, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x22, 0x20,
+    0x69, 0x64, 0x3d, 0x22, 0x52, 0x45, 0x4c, 0x41, 0x59, 0x33, 0x22, 0x20, 0x63, 0x6c, 0x61, 0x73,
+    0x73, 0x3d, 0x22, 0x62, 0x74, 0x6e, 0x20, 0x62, 0x74, 0x6e, 0x2d, 0x69, 0x6e, 0x66, 0x6f, 0x22,
+    0x20, 0x6f, 0x6e, 0x63, 0x6c, 0x69, 0x63, 0x6b, 0x3d, 0x22, 0x47, 0x65, 0x74, 0x42, 0x75, 0x74,
+    0x74, 0x6f, 0x6e, 0x28, 0x27, 0x52, 0x45, 0x4c, 0x41, 0x59, 0x33, 0x27, 0x2c, 0x20, 0x27, 0x32,
+    0x27, 0x29, 0x22, 0x3e, 0x03, 0x03, 0x03, 0x3c, 0x2f, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x3e,
+    0x3c, 0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x2f, 0x74, 0x72, 0x3e, 0x3c, 0x74, 0x72, 0x3e, 0x3c, 0x74,
+    0x64, 0x3e, 0x3c, 0x70, 0x3e, 0x42, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x20, 0x34, 0x20, 0x3c, 0x2f,
+    0x70, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x62, 0x75, 0x74, 0x74,
+    0x6f, 0x6e, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x22,
+    0x20, 0x69, 0x64, 0x3d, 0x22, 0x52, 0x45, 0x4c, 0x41, 0x59, 0x34, 0x22, 0x20, 0x63, 0x6c, 0x61,
+    0x73, 0x73, 0x3d, 0x22, 0x62, 0x74, 0x6e, 0x20, 0x62, 0x74, 0x6e, 0x2d, 0x69, 0x6e, 0x66, 0x6f,
+    0x22, 0x20, 0x6f, 0x6e, 0x63, 0x6c, 0x69, 0x63, 0x6b, 0x3d, 0x22, 0x47, 0x65, 0x74, 0x42, 0x75,
+    0x74, 0x74, 0x6f, 0x6e, 0x28, 0x27, 0x52, 0x45, 0x4c, 0x41, 0x59, 0x34, 0x27, 0x2c, 0x20, 0x27,
+    0x33, 0x27, 0x29, 0x22, 0x3e, 0x04, 0x04, 0x04, 0x3c, 0x2f, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e,
+    0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x2f, 0x74, 0x72, 0x3e, 0x3c, 0x74, 0x72, 0x3e, 0x3c,
+    0x74, 0x64, 0x3e, 0x3c, 0x70, 0x3e, 0x42, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x20, 0x35, 0x3c, 0x2f,
+    0x70, 0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x74, 0x64, 0x3e, 0x3c, 0x62, 0x75, 0x74, 0x74,
+    0x6f, 0x6e, 0x20, 0x74, 0x79, 0x70, 0x65, 0x3d, 0x22, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e, 0x22,
+    0x20, 0x69, 0x64, 0x3d, 0x22, 0x52, 0x45, 0x4c, 0x41, 0x59, 0x35, 0x22, 0x20, 0x63, 0x6c, 0x61,
+    0x73, 0x73, 0x3d, 0x22, 0x62, 0x74, 0x6e, 0x20, 0x62, 0x74, 0x6e, 0x2d, 0x69, 0x6e, 0x66, 0x6f,
+    0x22, 0x20, 0x6f, 0x6e, 0x63, 0x6c, 0x69, 0x63, 0x6b, 0x3d, 0x22, 0x47, 0x65, 0x74, 0x42, 0x75,
+    0x74, 0x74, 0x6f, 0x6e, 0x28, 0x27, 0x52, 0x45, 0x4c, 0x41, 0x59, 0x35, 0x27, 0x2c, 0x20, 0x27,
+    0x34, 0x27, 0x29, 0x22, 0x3e, 0x05, 0x05, 0x05, 0x3c, 0x2f, 0x62, 0x75, 0x74, 0x74, 0x6f, 0x6e,
+    0x3e, 0x3c, 0x2f, 0x74, 0x64, 0x3e, 0x3c, 0x2f, 0x74, 0x72, 0x3e, 0x3c, 0x2f, 0x74, 0x62, 0x6f,
+    0x64, 0x79, 0x3e, 0x3c, 0x2f, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x3e, 0x3c, 0x2f, 0x64, 0x69, 0x76,
+    0x3e, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x3c, 0x2f, 0x64,
+    0x69, 0x76, 0x3e, 0x3c, 0x2f, 0x73, 0x65, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x3e, 0x3c, 0x66, 0x6f,
+    0x6f, 0x74, 0x65, 0x72, 0x3e, 0x3c, 0x64, 0x69, 0x76, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d,
+    0x22, 0x72, 0x6f, 0x77, 0x22, 0x3e, 0x3c, 0x64, 0x69, 0x76, 0x20, 0x63, 0x6c, 0x61, 0x73, 0x73,
+    0x3d, 0x22, 0x63, 0x6f, 0x6c, 0x2d, 0x6d, 0x64, 0x2d, 0x31, 0x32, 0x22, 0x3e, 0x3c, 0x70, 0x20,
+    0x63, 0x6c, 0x61, 0x73, 0x73, 0x3d, 0x22, 0x74, 0x65, 0x78, 0x74, 0x2d, 0x6d, 0x75, 0x74, 0x65,
+    0x64, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2d, 0x63, 0x65, 0x6e, 0x74, 0x65, 0x72, 0x22, 0x3e, 0x4a,
+    0x6f, 0x62, 0x61, 0x79, 0x65, 0x72, 0x20, 0x41, 0x72, 0x6d, 0x61, 0x6e, 0x20, 0x26, 0x63, 0x6f,
+    0x70, 0x79, 0x3b, 0x20, 0x32, 0x30, 0x31, 0x34, 0x20, 0x2d, 0x20, 0x32, 0x30, 0x31, 0x36, 0x3c,
+    0x2f, 0x70, 0x3e, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x3c,
+    0x2f, 0x66, 0x6f, 0x6f, 0x74, 0x65, 0x72, 0x3e, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x3c, 0x2f,
+    0x62, 0x6f, 0x64, 0x79, 0x3e, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x0a,
+};
+
+constexpr char BUNDLE_PATH_2[] PROGMEM = "/b5074411.css";
+const byte BUNDLE_DATA_2[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x58, 0x5b, 0x8f, 0xa3, 0x36,
+    0x14, 0x7e, 0xef, 0xaf, 0xa0, 0x33, 0x5a, 0xed, 0xcc, 0x0a, 0x22, 0x20, 0x21, 0x99, 0x80, 0x76,
+    0xb4, 0x55, 0x2b, 0xb5, 0x95, 0xba, 0x7d, 0xda, 0x87, 0xbe, 0x1a, 0x30, 0xc1, 0x5d, 0xc0, 0xc8,
+    0x38, 0xc9, 0xcc, 0x22, 0xfe, 0x7b, 0x8f, 0x2f, 0x80, 0xb9, 0xcc, 0xec, 0x45, 0x9d, 0x28, 0x1a,
+    0x72, 0xec, 0x73, 0xb1, 0xfd, 0x9d, 0xef, 0x1c, 0x93, 0xf3, 0xb2, 0x68, 0x33, 0x5a, 0x71, 0x27,
+    0x43, 0x25, 0x29, 0x9e, 0xc3, 0x06, 0x55, 0x8d, 0xd3, 0x60, 0x46, 0xb2, 0xc8, 0x29, 0x1b, 0x87,
+    0xe3, 0x27, 0xee, 0x34, 0xe4, 0x0b, 0x76, 0x50, 0xfa, 0xef, 0xb9, 0xe1, 0xa1, 0xe7, 0xba, 0x6f,
+    0x22, 0xe7, 0x8a, 0xe3, 0xcf, 0x84, 0xaf, 0x8f, 0x76, 0x31, 0x4d, 0x9f, 0xdb, 0x12, 0xb1, 0x13,
+    0xa9, 0x42, 0xb7, 0xcb, 0x28, 0xe5, 0x98, 0xd9, 0x15, 0xba, 0xd8, 0x0d, 0x4e, 0x38, 0xa1, 0x55,
+    0x9b, 0x92, 0xa6, 0x2e, 0xd0, 0x73, 0x18, 0x17, 0x34, 0xf9, 0xdc, 0xc5, 0x67, 0xce, 0x41, 0x98,
+    0xd0, 0x82, 0xb2, 0x90, 0x54, 0x39, 0xf8, 0xe6, 0x91, 0x08, 0x69, 0xf8, 0xd1, 0xdb, 0x8a, 0xe8,
+    0x05, 0xb3, 0xac, 0xa0, 0xd7, 0xf0, 0x42, 0x1a, 0x12, 0x17, 0x38, 0x92, 0x01, 0x70, 0x06, 0x31,
+    0x67, 0x94, 0x95, 0x61, 0x45, 0x2b, 0x3c, 0x04, 0x87, 0xea, 0x1a, 0x23, 0x18, 0x4a, 0x70, 0xa8,
+    0x5c, 0x44, 0xc9, 0x99, 0x35, 0xe0, 0xa3, 0xa6, 0xa4, 0x82, 0x90, 0xb4, 0xe3, 0x30, 0x74, 0x4a,
+    0xfa, 0xc5, 0xc9, 0x68, 0x72, 0x6e, 0x1c, 0x52, 0x55, 0x98, 0xb5, 0x31, 0x65, 0x29, 0x66, 0xe0,
+    0xaf, 0x46, 0x69, 0x4a, 0xaa, 0x13, 0xac, 0x82, 0x23, 0x70, 0xa7, 0x07, 0x1c, 0x08, 0xb5, 0x40,
+    0x75, 0x83, 0xc3, 0xfe, 0x21, 0xd2, 0x03, 0x4d, 0x8d, 0x12, 0x3d, 0x3f, 0x6d, 0x47, 0xe5, 0x77,
+    0x76, 0x88, 0x32, 0xb1, 0x09, 0x61, 0x8c, 0x21, 0x4e, 0xdc, 0x4a, 0x8f, 0x31, 0x7d, 0x12, 0x7b,
+    0x27, 0xa6, 0x68, 0x75, 0x90, 0x44, 0xab, 0xd2, 0x2e, 0x1f, 0x8e, 0x49, 0xec, 0x36, 0x6c, 0x73,
+    0xfd, 0x34, 0x1e, 0x02, 0xaa, 0x9d, 0x9c, 0x9c, 0xf2, 0x02, 0xbe, 0xdc, 0x51, 0xdb, 0x28, 0xb7,
+    0xa4, 0x46, 0x0c, 0x57, 0x5c, 0x1d, 0x87, 0xa1, 0x1b, 0x80, 0x6e, 0x41, 0x2a, 0xec, 0xe4, 0x58,
+    0x68, 0x84, 0xde, 0x66, 0xe7, 0x3f, 0x04, 0x07, 0x6f, 0xb7, 0x8d, 0x94, 0xf2, 0xad, 0x9f, 0x6c,
+    0x71, 0xe0, 0x46, 0x31, 0x4a, 0x3e, 0x9f, 0x18, 0x3d, 0x57, 0xa9, 0xb6, 0x7a, 0x9b, 0x65, 0x59,
+    0x7f, 0x5c, 0x26, 0x66, 0xcc, 0x43, 0x53, 0x4e, 0x7a, 0x89, 0xe9, 0x47, 0xcb, 0xba, 0xdc, 0xb7,
+    0xf3, 0xed, 0x44, 0xff, 0x2f, 0xc4, 0xa9, 0x7d, 0xf3, 0x07, 0x2e, 0x2e, 0x98, 0x93, 0x04, 0x59,
+    0x7f, 0xe3, 0x33, 0xbe, 0xb1, 0x87, 0xdf, 0xf6, 0x2f, 0x8c, 0xa0, 0xc2, 0x36, 0x90, 0x29, 0x95,
+    0xaf, 0xca, 0xec, 0xce, 0x75, 0x67, 0xcb, 0xf1, 0xa2, 0x29, 0x96, 0x14, 0x7c, 0x1c, 0x4e, 0xeb,
+    0xd0, 0xf7, 0x60, 0xf1, 0xfa, 0x77, 0x4c, 0x61, 0x21, 0x25, 0xec, 0xe5, 0x06, 0x76, 0x04, 0xa2,
+    0x32, 0xf6, 0x68, 0xeb, 0x0b, 0xc9, 0xd6, 0x90, 0xf8, 0x7b, 0x90, 0xd4, 0x03, 0xaa, 0x2d, 0xd7,
+    0xd2, 0x7a, 0x1b, 0x09, 0xc1, 0x04, 0x0b, 0x44, 0xb5, 0xf2, 0x19, 0xc1, 0x41, 0x54, 0xa1, 0x92,
+    0xe8, 0xe1, 0xf2, 0xcc, 0x71, 0xaa, 0x11, 0x7e, 0x1b, 0xef, 0xe2, 0x24, 0xf1, 0xbb, 0x4d, 0x02,
+    0xc6, 0x11, 0x11, 0x78, 0xd3, 0x01, 0x31, 0x19, 0x3f, 0x3a, 0x73, 0xda, 0x87, 0x58, 0xe0, 0x4c,
+    0x0b, 0x34, 0x98, 0x94, 0x44, 0x1e, 0x61, 0x2f, 0x51, 0x5a, 0x42, 0xd4, 0x7d, 0x28, 0x71, 0x4a,
+    0x90, 0x75, 0x57, 0x82, 0xea, 0x95, 0xa4, 0x3c, 0x0f, 0x0f, 0xfb, 0x87, 0xfa, 0xe9, 0xbe, 0x35,
+    0x7c, 0x69, 0x79, 0x00, 0x08, 0xea, 0x56, 0x14, 0x8e, 0x47, 0x7f, 0x55, 0xe1, 0x78, 0x78, 0x41,
+    0xc1, 0xf3, 0x5d, 0x77, 0x55, 0xc3, 0xf3, 0x94, 0xca, 0x86, 0xd1, 0x6b, 0x6b, 0xae, 0xc7, 0x91,
+    0xe1, 0x4f, 0xd6, 0x2c, 0x45, 0x62, 0x47, 0x0a, 0xa7, 0x4c, 0x9d, 0x5d, 0x5b, 0xd3, 0x86, 0x08,
+    0xa6, 0x08, 0x19, 0x2e, 0x10, 0x27, 0x17, 0x1c, 0x09, 0x87, 0xfd, 0x01, 0x1b, 0x8b, 0xff, 0xce,
+    0xed, 0x18, 0x57, 0xa7, 0x1d, 0x01, 0x99, 0x20, 0x1e, 0x0a, 0x2b, 0x86, 0x77, 0x35, 0x77, 0xbb,
+    0xdd, 0x6c, 0xf5, 0xdf, 0x9b, 0x61, 0x90, 0x66, 0x59, 0x83, 0x39, 0xcc, 0x31, 0x17, 0x34, 0x99,
+    0xd9, 0x33, 0xc5, 0x3c, 0x77, 0xcc, 0x8c, 0xdc, 0xa8, 0x39, 0x7a, 0x9f, 0x04, 0xa1, 0x96, 0xe8,
+    0xc9, 0x99, 0xfc, 0x34, 0x11, 0x2a, 0x40, 0xab, 0x75, 0x1e, 0xb9, 0xc8, 0xe6, 0x47, 0xce, 0x1e,
+    0x0d, 0x82, 0x79, 0x78, 0x39, 0xa1, 0x81, 0x2f, 0x45, 0x06, 0x15, 0x1a, 0x94, 0x90, 0x02, 0xda,
+    0x90, 0xd3, 0x70, 0x46, 0x6a, 0x9c, 0x0e, 0x06, 0xc3, 0x8a, 0xe7, 0xb0, 0x3c, 0x87, 0x3f, 0xd7,
+    0xf8, 0x8e, 0xa6, 0xe9, 0x7d, 0xbb, 0x92, 0xfe, 0x47, 0xf1, 0xe9, 0x36, 0x31, 0x1f, 0x39, 0x9c,
+    0x54, 0xd2, 0xb5, 0xa4, 0xf2, 0x59, 0xdc, 0xee, 0x22, 0x4f, 0x17, 0xf9, 0x31, 0x0f, 0xb0, 0x24,
+    0x69, 0x0a, 0xb4, 0x2e, 0x2b, 0x0f, 0x3d, 0x27, 0xb9, 0x83, 0x64, 0xc5, 0x08, 0x4b, 0x54, 0x91,
+    0xfa, 0x2c, 0xb0, 0x00, 0x34, 0xfe, 0xf2, 0xc8, 0x94, 0xe0, 0x4d, 0x02, 0x23, 0x25, 0x3a, 0x61,
+    0x55, 0x1f, 0x34, 0xbb, 0xc3, 0xa6, 0x5a, 0x0d, 0x2d, 0x48, 0x6a, 0x19, 0x47, 0x13, 0x5d, 0x73,
+    0xc2, 0xb1, 0xe4, 0x71, 0x31, 0xfb, 0xca, 0x50, 0x3d, 0x14, 0x01, 0x41, 0xba, 0x96, 0xc4, 0xda,
+    0xb7, 0x91, 0xa9, 0xa6, 0x6f, 0x86, 0x52, 0x72, 0x6e, 0xc2, 0x9d, 0xc1, 0xd8, 0xe7, 0x46, 0xd4,
+    0x0a, 0x5c, 0x40, 0x39, 0xd4, 0x25, 0x4b, 0xd4, 0x83, 0x15, 0x69, 0xb3, 0x14, 0xce, 0x05, 0xf2,
+    0x34, 0x42, 0xb1, 0x19, 0x17, 0x1c, 0xca, 0x22, 0x66, 0x4b, 0x89, 0x7c, 0x6c, 0xe9, 0x99, 0x8b,
+    0xe8, 0xc2, 0x14, 0x4e, 0x04, 0xc3, 0x4a, 0x73, 0x52, 0x45, 0xbd, 0xac, 0x8f, 0x46, 0x55, 0x3e,
+    0x26, 0x92, 0x47, 0x9e, 0xb3, 0x25, 0x09, 0x47, 0xcf, 0xd2, 0x88, 0x0f, 0x1d, 0xc1, 0x88, 0xa3,
+    0x61, 0xe5, 0x23, 0x17, 0xf5, 0xb8, 0x1d, 0x6b, 0x83, 0x3a, 0xdf, 0x14, 0x27, 0x94, 0xc9, 0xf3,
+    0x58, 0x04, 0x38, 0xc4, 0xe3, 0x4a, 0x29, 0x94, 0xdb, 0x8c, 0x9a, 0xfa, 0x4b, 0xc8, 0x6d, 0x77,
+    0xc7, 0x87, 0x34, 0x1e, 0x67, 0xeb, 0x75, 0x99, 0x3a, 0x43, 0x4d, 0x16, 0x12, 0x6f, 0x1f, 0xf8,
+    0x07, 0x64, 0xcc, 0x57, 0x8e, 0xed, 0x51, 0xb0, 0x08, 0x7a, 0xe9, 0xd4, 0xf7, 0x0e, 0x69, 0x1c,
+    0xcf, 0x2c, 0xfb, 0xee, 0xe1, 0x10, 0xfb, 0x0b, 0xcb, 0xc6, 0x7e, 0x4c, 0xc4, 0xdf, 0xe0, 0xc6,
+    0x4b, 0xf6, 0xc7, 0x63, 0xfa, 0x6d, 0x0b, 0x68, 0x57, 0xb1, 0xdc, 0x6d, 0xa0, 0xad, 0x8a, 0x11,
+    0x7b, 0x9d, 0x30, 0xf7, 0xee, 0xa2, 0xe8, 0xc9, 0x3a, 0xf8, 0x5a, 0x22, 0xbc, 0x52, 0x4b, 0xb4,
+    0xcb, 0x05, 0xbc, 0xbb, 0x3e, 0x1a, 0x40, 0x40, 0x86, 0xce, 0x05, 0x5f, 0x61, 0x90, 0xbe, 0xb3,
+    0x30, 0x97, 0x3c, 0x61, 0xc6, 0x1a, 0x55, 0xb8, 0x68, 0xd7, 0x82, 0x5d, 0x6b, 0x46, 0x5e, 0xcf,
+    0xe5, 0x65, 0x84, 0xca, 0xbc, 0x23, 0x3b, 0xa2, 0x21, 0xad, 0x83, 0x71, 0x20, 0xc7, 0x48, 0xc8,
+    0xda, 0x65, 0xca, 0x0f, 0xbd, 0x98, 0xea, 0x19, 0x5e, 0xf3, 0x07, 0x24, 0xab, 0xaa, 0x50, 0xef,
+    0x79, 0x3b, 0xea, 0x8b, 0x31, 0x51, 0x33, 0x8c, 0xa1, 0xde, 0x37, 0x27, 0x1c, 0x6a, 0x82, 0xd1,
+    0xab, 0xb8, 0xeb, 0x74, 0xaa, 0x78, 0xe7, 0x00, 0x36, 0x27, 0x5d, 0x4e, 0x6f, 0xa6, 0x66, 0x00,
+    0x0f, 0xf6, 0xdc, 0xce, 0xc0, 0x2b, 0xf7, 0x7d, 0x36, 0xe7, 0x71, 0xb6, 0xea, 0xd7, 0x73, 0x62,
+    0xe5, 0xe4, 0x06, 0xb3, 0x43, 0xed, 0xd7, 0x7d, 0xae, 0x21, 0x50, 0x1d, 0xaf, 0xad, 0xa1, 0xd1,
+    0x8f, 0xeb, 0x5f, 0xfd, 0xe0, 0x78, 0x2c, 0xfd, 0x04, 0x43, 0xd2, 0x4f, 0x82, 0x3e, 0xa2, 0x1f,
+    0x15, 0x8f, 0xba, 0x95, 0x16, 0x9e, 0x60, 0xf3, 0xc3, 0x1b, 0xeb, 0x26, 0xea, 0x6b, 0x92, 0xac,
+    0x70, 0x2b, 0x51, 0x4d, 0x63, 0x58, 0x3a, 0x1d, 0x3c, 0xb4, 0x49, 0x81, 0x45, 0x78, 0x94, 0xe7,
+    0xdd, 0x07, 0x41, 0xc3, 0x17, 0x82, 0xaf, 0x35, 0x65, 0x5c, 0xd7, 0xec, 0x14, 0x5f, 0x48, 0x82,
+    0x55, 0x5e, 0x74, 0xb3, 0x84, 0x50, 0x33, 0x14, 0xc1, 0x4d, 0x65, 0x03, 0x85, 0xf6, 0x29, 0x2d,
+    0x5a, 0xfd, 0x1c, 0xa5, 0xe0, 0x55, 0x25, 0xf3, 0xa2, 0xc4, 0xdb, 0xcb, 0xa2, 0xaf, 0x11, 0x3f,
+    0x30, 0xab, 0xe2, 0x50, 0x75, 0x11, 0x53, 0xb6, 0x5c, 0xcb, 0x11, 0xf8, 0x74, 0x2d, 0x76, 0x8a,
+    0xd1, 0x9d, 0x6b, 0x8b, 0xcf, 0xc6, 0xbf, 0x8f, 0x0c, 0x77, 0xa4, 0x02, 0x4e, 0x17, 0x3d, 0xec,
+    0x38, 0xcf, 0x0f, 0x02, 0xbb, 0xff, 0x6e, 0xbc, 0xe0, 0xde, 0x56, 0xa3, 0xe2, 0x6b, 0xda, 0x71,
+    0x0f, 0xc1, 0xfd, 0x0a, 0x39, 0x2d, 0x4d, 0x03, 0xb2, 0xad, 0x60, 0xa6, 0xec, 0xf9, 0x5a, 0xf9,
+    0x2b, 0xa4, 0x36, 0x2c, 0x6b, 0x31, 0xde, 0xd7, 0x2c, 0x51, 0x44, 0x80, 0x68, 0x4e, 0x22, 0x8d,
+    0xe0, 0xf4, 0xef, 0x20, 0x5f, 0xec, 0xdb, 0x20, 0x4e, 0xdc, 0x14, 0x5b, 0xae, 0x7d, 0xeb, 0x23,
+    0x14, 0xa7, 0xbe, 0x25, 0x7a, 0xa9, 0xfb, 0x65, 0x17, 0xb0, 0x54, 0xb6, 0x54, 0x8a, 0xbd, 0x68,
+    0x22, 0x23, 0x05, 0xa0, 0x22, 0xac, 0x19, 0x3d, 0x91, 0x34, 0xfc, 0xed, 0x9f, 0x3f, 0x85, 0x9d,
+    0x4f, 0xfd, 0xb5, 0x73, 0xf3, 0x91, 0x24, 0x8c, 0x36, 0x34, 0xe3, 0x9b, 0xc1, 0x66, 0xc3, 0x11,
+    0xe3, 0xbf, 0x8a, 0x2c, 0x81, 0x46, 0xeb, 0xfd, 0x5b, 0x48, 0x2a, 0x65, 0xfa, 0xad, 0x6d, 0xe1,
+    0x2a, 0x9d, 0x0c, 0x28, 0x4f, 0x30, 0xf0, 0xbb, 0x56, 0xfe, 0x04, 0x2d, 0xd8, 0x7b, 0xf7, 0x47,
+    0xbc, 0xe2, 0x4a, 0xe0, 0x25, 0x7d, 0x9f, 0xa1, 0xa2, 0xc1, 0x93, 0x95, 0x33, 0x0c, 0x97, 0x61,
+    0x1e, 0xaa, 0x7f, 0xce, 0xd3, 0x3c, 0x8f, 0x1f, 0xd0, 0x2e, 0x39, 0xce, 0xab, 0xec, 0xa2, 0x68,
+    0xae, 0xb0, 0x82, 0x8c, 0xdd, 0x74, 0x34, 0x54, 0x22, 0x01, 0xc3, 0x40, 0x23, 0xfe, 0xa5, 0x4a,
+    0x36, 0xb3, 0xb2, 0x1a, 0x93, 0xaa, 0x08, 0x06, 0xc2, 0x14, 0x30, 0xfd, 0x39, 0x30, 0x05, 0xb4,
+    0x5e, 0xa5, 0xb7, 0xef, 0x03, 0x93, 0xa2, 0x36, 0x89, 0x84, 0xed, 0xd6, 0xdb, 0xb9, 0x3f, 0x00,
+    0xa6, 0xaf, 0x9b, 0x98, 0x9f, 0xca, 0xff, 0x81, 0x33, 0xe5, 0x75, 0x0d, 0x67, 0x32, 0x88, 0x25,
+    0xce, 0xba, 0x59, 0xaf, 0xe8, 0xfe, 0x4c, 0x4a, 0xc1, 0x75, 0x68, 0xf2, 0xee, 0x40, 0x5f, 0xd5,
+    0x3f, 0xc2, 0x33, 0x74, 0xa0, 0xd0, 0xdf, 0x7d, 0xd7, 0x85, 0x7d, 0xf6, 0x9e, 0xe6, 0x5c, 0xd7,
+    0x98, 0x25, 0xa8, 0xc1, 0x93, 0x1b, 0xc2, 0xc1, 0x35, 0xdf, 0x39, 0x00, 0x02, 0xf6, 0xe2, 0x33,
+    0xf6, 0x38, 0x66, 0x51, 0x76, 0x2d, 0x5f, 0x82, 0x4b, 0x8d, 0x59, 0xef, 0xcc, 0xe2, 0x35, 0xb7,
+    0x59, 0x60, 0x68, 0x7e, 0xc7, 0x97, 0x33, 0x82, 0x86, 0x6f, 0x45, 0x6d, 0x60, 0xb4, 0x68, 0x4d,
+    0x7f, 0x5e, 0x80, 0x82, 0x87, 0xe3, 0xd0, 0xef, 0xfb, 0xaa, 0x6d, 0x7a, 0x1a, 0x5a, 0xfb, 0x95,
+    0x9b, 0x99, 0xb8, 0xe1, 0xea, 0x17, 0x22, 0xba, 0x49, 0x72, 0x87, 0xbb, 0x9a, 0x55, 0xf7, 0x21,
+    0xcb, 0x72, 0xee, 0xf9, 0xe3, 0x48, 0xff, 0x0e, 0x45, 0xde, 0x3e, 0x65, 0xaf, 0xa0, 0x5f, 0x93,
+    0x0d, 0x8b, 0x14, 0xab, 0xb3, 0xfc, 0xa1, 0xfd, 0x98, 0x86, 0x31, 0x69, 0x87, 0xa0, 0x47, 0x0e,
+    0x76, 0xf1, 0xde, 0x8d, 0x8c, 0x77, 0x34, 0xca, 0xd8, 0x2c, 0x80, 0xbd, 0x79, 0x25, 0x1e, 0xee,
+    0x9b, 0x87, 0xfd, 0x41, 0x74, 0x75, 0xc6, 0x4b, 0x19, 0xf5, 0xbe, 0x03, 0x97, 0xb3, 0x7b, 0xcd,
+    0x76, 0xdc, 0xb4, 0x95, 0x4d, 0xd0, 0xe1, 0x2f, 0x2f, 0x78, 0xb3, 0x0d, 0xec, 0xba, 0x9f, 0xfe,
+    0x03, 0x32, 0x96, 0x56, 0xab, 0x73, 0x14, 0x00, 0x00,
+};
+
+constexpr BundleFile BUNDLE[] PROGMEM = {
+    { PathHash(BUNDLE_PATH_0), BUNDLE_PATH_0, BUNDLE_DATA_0, 841, true, 0x035893bdUL },
+    { PathHash(BUNDLE_PATH_1), BUNDLE_PATH_1, BUNDLE_DATA_1, 1757, false, 0xe2a68220UL },
+    { PathHash(BUNDLE_PATH_2), BUNDLE_PATH_2, BUNDLE_DATA_2, 1689, true, 0x1479c514UL },
+};
@@ -41,18 +41,645 @@
                 - refactored XML response function
                 - unused variable removed (index.htm)
 
+                15 Oct 2026
+                - streaming HTTP request parser replaces the
+                  HTTP_req buffer and StrContains() scans
+                - request bytes read from the socket in blocks
+                - relay commands matched in a single pass
+                - requests dispatched through a route table,
+                  unknown paths answered with 404
+                - needs Arduino 1.6.6 or later (C++11 constexpr)
+                - HTTP keep-alive, responses carry Content-Length
+                - all W5100 sockets served concurrently, needs
+                  Ethernet library 2.0 or later
+                - deadline for every stage of a connection,
+                  stalled clients are dropped; a connection is closed
+                  once the client has acknowledged the response, and
+                  stop() waits at most CLOSE_MS for the close
+                - explicit function prototypes, the sketch also
+                  compiles as plain C++ (e.g. for host builds
+                  against stand-ins of the libraries)
+                - response headers and XML sent in coalesced blocks
+                - string literals and constant tables kept in flash
+                - button_state response pre-rendered, fields patched
+                  only when a relay or the temperature changes
+                - compact state endpoint, plain text or JSON
+                - state responses carry an ETag from a state version
+                  counter, If-None-Match answered with 304
+                - long-poll on the state endpoint, the answer waits
+                  until the state differs from the version sent
+                - /events Server-Sent Events stream, every state change
+                  serialized once for all subscribers, Last-Event-ID
+                  resumes without a repeated event
+                - at most PARKED_MAX long-polls, event streams and
+                  WebSockets, further ones answered with 503 rather
+                  than closing a subscriber
+                - /ws WebSocket (RFC 6455), one byte binary frames
+                  switch the RELAYs, the state is pushed back
+                - files streamed in TX_BUF_SZ blocks, up to one SD
+                  sector per pass, as far as the socket has room
+                - files of the SD card root cached at boot with their
+                  path hash, size and content hash; requests for files
+                  that are not there never touch the card
+                - gzip compressed siblings of the files (index.htz for
+                  index.htm, made by tools/build_site.py) sent with
+                  Content-Encoding: gzip when the client accepts it
+                - files carry an ETag from their cached size and
+                  content hash, If-None-Match answered with 304 without
+                  opening the file; Cache-Control set per file
+                - page split into index.htm, style.css and app.js,
+                  Content-Type from a table of file name extensions,
+                  files with content hash names cached for a year
+                - web files bundled into flash by tools/build_site.py
+                  (site_bundle.h) and sent from there, the card is only
+                  read for other files; the server starts without card
+                - web files minified by tools/build_site.py, unused
+                  styles and the font and CDN references dropped; the
+                  build fails over a byte budget (--budget)
+                - RELAY states and temperature filled into the page
+                  while it is sent, replacing placeholders marked by
+                  tools/build_site.py, so the first paint is current
+                - /favicon.ico answered with a cacheable 204 unless
+                  there is such a file, the page names no icon
+
   Author:       W.A. Smith, http://startingelectronics.com
   --------------------------------------------------------------*/
 
+#include <Arduino.h>
 #include <SPI.h>
 #include <Ethernet.h>
 #include <SD.h>
 #include <Thermistor.h>
 
-// size of buffer used to capture HTTP requests
-#define REQ_BUF_SZ   60
 #define BTN_NUM       5
 
+// uncomment to print socket call counters and free SRAM on the
+// serial port
+//#define DEBUG_STATS
+
+// stages of a connection, each one with its own deadline
+#define ST_IDLE       0     // kept alive, waiting for a request to start
+#define ST_HEADER     1     // waiting for the blank line ending the request
+#define ST_DRAIN      2     // sending the response
+#define ST_CLOSE      3     // response sent, waiting for its acknowledgement
+#define ST_WAIT       4     // long-poll, waiting for the state to change
+#define ST_STREAM     5     // subscribed to /events
+#define ST_WEBSOCKET  6     // upgraded to a WebSocket
+
+// time allowed in each stage, in ms
+#define KEEP_ALIVE_MS  5000 // idle between requests
+#define HEADER_MS      3000 // from connect or first byte to complete request
+#define DRAIN_MS       5000 // without the client accepting a response block
+#define LONG_POLL_MS  20000 // for the state to change, then answered anyway
+#define EVENT_PING_MS 30000 // between writes to an /events stream
+
+// time a kept-alive connection has to be idle, or a long-poll parked,
+// before it is closed for a new client; longer than the 1 s between
+// polls of the page, so clients that are using their connection keep
+// it; also the time between two busy connections asked to close, so a
+// client refused by the W5100 while all sockets are in use gets a turn
+#define RESERVE_IDLE_MS  2000
+
+// time stop() may wait for the client to acknowledge the close, set on
+// every connection: stop() blocks the whole server while it waits
+#define CLOSE_MS         10
+
+// bytes of the transmit buffer of each W5100 socket, all of it is free
+// once the client has acknowledged everything sent
+#define SOCK_TX_SZ     2048
+
+// reasons for dropping a connection, the first ones match the stages
+#define DROP_IDLE     ST_IDLE       // idle for KEEP_ALIVE_MS
+#define DROP_HEADER   ST_HEADER     // request not complete within HEADER_MS
+#define DROP_DRAIN    ST_DRAIN      // client stalled during the response
+#define DROP_RESERVE  3             // closed to free a socket for new clients
+#define DROP_NUM      4
+
+// connections parked in ST_WAIT or later at most, long-polls, event
+// streams and WebSockets; the socket left over serves everyone else,
+// further subscriptions are answered with 503 and Retry-After seconds
+#define PARKED_MAX    (MAX_SOCK_NUM - 1)
+#define RETRY_AFTER_S    5
+
+// room in the socket a response is only started with, enough for every
+// response but the body of a file, which StreamFile() sends as room
+// frees up; a write without room would block the whole server inside
+// the Ethernet library until the client has taken enough
+#define RESPONSE_ROOM   384
+
+// size of the ring buffer between the socket and the request parser
+// of each connection, must be a power of 2
+#define RX_BUF_SZ    32
+
+// bytes of a file sent to one connection per pass of loop() at most,
+// one SD sector, sent in blocks of TX_BUF_SZ
+#define STREAM_PASS_SZ  512
+
+// files of the SD card root the file cache has room for
+#define FILE_NUM          8
+
+// Cache-Control max-age of files without an entry in CACHE_RULES,
+// in seconds
+#define FILE_MAX_AGE   3600UL
+
+// Cache-Control max-age of files named by a hash of their contents,
+// such as 1f2e3d4c.css from tools/build_site.py; a new version of
+// such a file always has a new name, so it may be cached for a year
+#define HASHED_MAX_AGE 31536000UL
+#define HASHED_NAME_LEN  8      // hex digits before the extension
+
+// Cache-Control max-age of the empty answer to /favicon.ico, a week
+#define FAVICON_MAX_AGE 604800UL
+
+// placeholders of the live state in the pages, from tools/build_site.py
+// each is a run of FILL_ marker bytes as wide as its value, replaced
+// with the state while the page is sent
+#define FILL_RELAY        1     // RELAY1, FILL_RELAY + 1 is RELAY2 ...
+#define FILL_RELAY_W      3     // "ON " or "OFF"
+#define FILL_TEMP         (FILL_RELAY + BTN_NUM)
+#define FILL_TEMP_W       4     // celsius, padded with spaces
+
+// size of the buffer an /events state event is serialized into
+#define EVENT_BUF_SZ     64
+
+// length of Sec-WebSocket-Key, 16 random bytes in base64
+#define WS_KEY_LEN       24
+#define SHA1_DIGEST_SZ   20
+
+// control frame payload a WebSocket connection keeps for the pong,
+// the rest of a longer payload is received but not echoed
+#define WS_CTL_SZ         8
+// longest control frame payload RFC 6455 allows
+#define WS_CTL_MAX      125
+
+// WebSocket frame opcodes
+#define WS_OP_CONT      0x0
+#define WS_OP_BINARY    0x2
+#define WS_OP_CLOSE     0x8
+#define WS_OP_PING      0x9
+#define WS_OP_PONG      0xA
+#define WS_FIN          0x80
+
+// states of the WebSocket frame parser
+#define WF_HEAD       0     // FIN and opcode
+#define WF_LEN        1     // mask bit and 7 bit length
+#define WF_LEN_HI     2     // 16 bit length, high byte
+#define WF_LEN_LO     3     // 16 bit length, low byte
+#define WF_MASK       4     // 4 byte masking key
+#define WF_DATA       5     // payload
+
+// relay command byte: RELAY number in the low bits, WS_CMD_ON to switch
+// it on, clear to switch it off
+#define WS_CMD_ON       0x80
+
+// the temperature is sampled every TEMP_SAMPLE_MS
+#define TEMP_SAMPLE_MS  1000
+
+// size of the buffer collecting response headers and generated bodies,
+// every full buffer is one write to the W5100 and one TCP segment
+#define TX_BUF_SZ       128
+
+// sizes of the fixed buffers used by the HTTP request parser
+#define PATH_BUF_SZ  20     // request path, longer paths are flagged
+
+// length of RELAY_KEY, the name of the relay command parameters
+#define RELAY_KEY_LEN   (sizeof(RELAY_KEY) - 1)
+
+// states of the relay command matcher, below RM_NUMBER it is the
+// number of characters of RELAY_KEY matched
+#define RM_NUMBER     (RELAY_KEY_LEN)       // relay number digits
+#define RM_VALUE      (RELAY_KEY_LEN + 1)   // '=' seen, expecting 0 or 1
+#define RM_MATCH      (RELAY_KEY_LEN + 2)   // complete RELAYn=v
+#define RM_FAIL       0xFF                  // not a relay command
+
+// states of the long-poll parameter matcher, v=<state version>
+#define WM_KEY        0     // expecting 'v'
+#define WM_EQUALS     1     // expecting '='
+#define WM_FIRST      2     // expecting the first digit
+#define WM_DIGITS     3     // digits of the version
+#define WM_FAIL       0xFF  // not the long-poll parameter
+
+// HTTP request methods recognized by the parser
+#define METHOD_OTHER  0
+#define METHOD_GET    1
+
+// request headers the parser looks at, all others are skipped
+#define HDR_OTHER       0
+#define HDR_CONNECTION  1
+#define HDR_ACCEPT      2
+#define HDR_IF_NONE_MATCH 3
+#define HDR_LAST_EVENT_ID 4
+#define HDR_UPGRADE     5
+#define HDR_WS_KEY      6
+#define HDR_ACCEPT_ENCODING 7
+
+// flag in HttpRequest.etagKind
+#define ETAG_DONE       0x80
+
+// states of the HTTP request parser
+enum ParseState {
+    PS_METHOD,      // request method, up to the first space
+    PS_PATH,        // request path, up to '?', '&' or space
+    PS_QUERY_KEY,   // query parameter name, up to '=' or '&'
+    PS_QUERY_VAL,   // query parameter value, up to '&'
+    PS_VERSION,     // protocol version, remainder of the request line
+    PS_HEADER_NAME, // header name, up to ':' or a blank line
+    PS_HEADER_VALUE,// header value, up to the end of the line
+    PS_DONE         // blank line received, request complete
+};
+
+// state of one HTTP request, filled in one byte at a time as it arrives
+struct HttpRequest {
+    byte state;                 // current ParseState
+    byte method;                // METHOD_GET or METHOD_OTHER
+    byte index;                 // characters of the current element seen
+    boolean keepAlive;          // keep the connection open after response
+    boolean acceptJson;         // Accept header lists application/json
+    boolean acceptGzip;         // Accept-Encoding header lists gzip
+    byte etagKind;              // kind letter of the If-None-Match ETag,
+                                // ETAG_DONE set once it has ended
+    unsigned long etagVersion;  // state version of the If-None-Match ETag
+    byte header;                // HDR_ id of the current header
+    uint16_t hash;              // PathHash() of the header name or token
+    boolean skipToken;          // rest of the header value token ignored
+    boolean pathTooLong;        // path did not fit into path[]
+    uint16_t pathHash;          // PathHash() of the path
+    char path[PATH_BUF_SZ];     // null terminated request path
+    byte pathLen;
+    byte relayMatch;            // relay command matcher state
+    byte relayNum;              // relay number of the parameter
+    boolean relayValue;         // value of the parameter
+    byte relayOn;               // bit n set: RELAY(n+1)=1 requested
+    byte relayOff;              // bit n set: RELAY(n+1)=0 requested
+    byte waitMatch;             // long-poll parameter matcher state
+    boolean longPoll;           // v= given, answer once the state differs
+    unsigned long waitVersion;  // state version the client already has,
+                                // from v= or Last-Event-ID; for /events
+                                // the version last sent on the stream
+    boolean upgradeWs;          // Upgrade: websocket
+};
+
+// state of a connection upgraded to a WebSocket, shares its memory
+// with the HttpRequest that is no longer needed
+struct WsConn {
+    byte state;                 // WF_ state of the frame parser
+    byte opcode;                // opcode of the frame being received
+    uint16_t remaining;         // payload bytes left in the frame
+    byte mask[4];               // masking key of the frame
+    byte pos;                   // payload bytes received, wraps
+    byte ctlLen;                // payload length of a control frame
+    byte ctl[WS_CTL_SZ];        // start of the payload of a ping, echoed
+    unsigned long sentVersion;  // state version last pushed
+};
+
+// bytes received from the socket that the parser has not consumed yet
+struct RxRing {
+    byte buf[RX_BUF_SZ];
+    byte head;                  // next free position
+    byte tail;                  // next byte for the parser
+};
+
+// one client connection, indexed by its W5100 socket number
+struct Conn {
+    boolean inUse;
+    EthernetClient client;
+    union {
+        HttpRequest req;        // request being received
+        WsConn ws;              // from the WebSocket upgrade on
+    };
+    RxRing rx;                  // received bytes waiting for the parser
+    File file;                  // file being sent, open while sending
+    const byte *flash;          // bundled file being sent, in flash
+    unsigned int flashLeft;     // bytes of it still to send
+    boolean fill;               // file is a page with FILL_ placeholders
+    byte fillPos;               // bytes of the placeholder sent so far
+    byte stage;                 // ST_ stage of the connection
+    unsigned long deadline;     // millis() at which the stage expires
+    byte requests;              // requests answered, saturates at 255
+    boolean closeNext;          // answer the next request with close
+};
+
+// handler that sends the response to the request of a connection
+// a handler may leave conn->file open or conn->flashLeft set, loop()
+// then sends the file
+typedef void (*RouteHandler)(Conn *conn);
+
+// one entry of the route table
+struct Route {
+    uint16_t hash;              // PathHash(path), computed by the compiler
+    byte method;
+    const char *path;
+    RouteHandler handler;
+};
+
+// a file of the SD card root, recorded at boot
+struct FileInfo {
+    uint16_t hash;              // PathHash() of "/" and the lower case name
+    uint16_t contentHash;       // PathHash() style hash of the contents
+    unsigned long size;
+};
+
+// hash of a request path, computed by the compiler for the route table
+// and one character at a time by the parser for the request,
+// starting from PATH_HASH_INIT
+#define PATH_HASH_INIT  5381
+
+constexpr uint16_t PathHashStep(uint16_t h, char c) {
+    return (uint16_t)(h * 33) ^ (byte)c;
+}
+
+constexpr uint16_t PathHashFrom(uint16_t h, const char *s) {
+    return *s ? PathHashFrom(PathHashStep(h, *s), s + 1) : h;
+}
+
+constexpr uint16_t PathHash(const char *s) {
+    return PathHashFrom(PATH_HASH_INIT, s);
+}
+
+// paths served, adding an endpoint only adds a path here and an entry
+// to ROUTES; the table and the paths live in flash
+constexpr char PATH_ROOT[] PROGMEM = "/";
+constexpr char PATH_INDEX[] PROGMEM = "/index.htm";
+constexpr char PATH_BUTTON_STATE[] PROGMEM = "/button_state";
+constexpr char PATH_STATE[] PROGMEM = "/state";
+constexpr char PATH_STATE_JSON[] PROGMEM = "/state.json";
+constexpr char PATH_EVENTS[] PROGMEM = "/events";
+constexpr char PATH_WS[] PROGMEM = "/ws";
+constexpr char PATH_FAVICON[] PROGMEM = "/favicon.ico";
+
+// hashes compared against at run time, as constants so that the
+// compiler computes them at any optimization level: PathHash() run on
+// the board would read the flash address of a path as RAM, and keep a
+// literal in SRAM
+constexpr uint16_t HASH_INDEX = PathHash(PATH_INDEX);
+constexpr uint16_t HASH_STATE_JSON = PathHash(PATH_STATE_JSON);
+constexpr uint16_t HASH_CLOSE = PathHash("close");
+constexpr uint16_t HASH_KEEP_ALIVE = PathHash("keep-alive");
+constexpr uint16_t HASH_JSON = PathHash("application/json");
+constexpr uint16_t HASH_GZIP = PathHash("gzip");
+constexpr uint16_t HASH_WEBSOCKET = PathHash("websocket");
+
+static_assert(sizeof(PATH_INDEX) <= PATH_BUF_SZ, "SendPage() puts PATH_INDEX in the request path");
+
+// a file of the web site kept in flash, from site_bundle.h
+struct BundleFile {
+    uint16_t hash;              // PathHash(path)
+    const char *path;
+    const byte *data;
+    unsigned int size;
+    bool gzip;                  // data is gzip compressed
+    unsigned long etag;         // hash of data, sent as ETag
+};
+
+// Cache-Control max-age of a file, 0 to have it revalidated every time
+struct CacheRule {
+    uint16_t hash;              // PathHash() of the file path
+    unsigned long maxAge;       // in seconds
+};
+
+// Content-Type of the files with a file name extension
+struct MimeType {
+    char ext[4];
+    const char *type;
+};
+
+// the bundle, generated by tools/build_site.py
+#include "site_bundle.h"
+#define BUNDLE_NUM  (sizeof(BUNDLE) / sizeof(BUNDLE[0]))
+
+// SendHeader() length of a response without Content-Length
+#define NO_LENGTH   0xFFFFFFFFUL
+
+// length of a string literal
+#define SLEN(s)   (sizeof(s) - 1)
+
+// the button_state response, header and XML, is kept ready to send in
+// XML_resp, built from these pieces; the values go into fixed width
+// fields that are patched in place, so the length never changes
+#define XML_HDR_STATUS  "HTTP/1.1 200 OK\r\nContent-Type: text/xml\r\nContent-Length: "
+#define XML_HDR_ETAG    "\r\nCache-Control: no-cache\r\nETag: \"x"
+#define XML_HDR_CONN    "\"\r\nConnection: "
+#define XML_HDR_END     "\r\n\r\n"
+#define XML_HEAD        "<?xml version = \"1.0\" ?><inputs><temp>"
+#define XML_BUTTON      "<BUTTON>"
+#define XML_TAIL        "</inputs>"
+
+// widths of the fields
+#define XML_LEN_W       3   // Content-Length digits
+#define XML_ETAG_W     10   // state version digits
+#define XML_CONN_W     10   // "keep-alive" or "close" padded with spaces
+#define XML_TEMP_W     11   // temperature, "</temp>" and padding spaces
+#define XML_STATE_W    14   // "on</BUTTON> \r\n" or "off</BUTTON>\r\n"
+
+// offsets of the fields in XML_resp
+#define XML_LEN_OFF     SLEN(XML_HDR_STATUS)
+#define XML_ETAG_OFF    (XML_LEN_OFF + XML_LEN_W + SLEN(XML_HDR_ETAG))
+#define XML_CONN_OFF    (XML_ETAG_OFF + XML_ETAG_W + SLEN(XML_HDR_CONN))
+#define XML_BODY_OFF    (XML_CONN_OFF + XML_CONN_W + SLEN(XML_HDR_END))
+#define XML_TEMP_OFF    (XML_BODY_OFF + SLEN(XML_HEAD))
+#define XML_BTN_OFF(i)  (XML_TEMP_OFF + XML_TEMP_W + \
+                         (i) * (SLEN(XML_BUTTON) + XML_STATE_W) + SLEN(XML_BUTTON))
+#define XML_RESP_LEN    (XML_BTN_OFF(BTN_NUM) - SLEN(XML_BUTTON) + SLEN(XML_TAIL))
+#define XML_BODY_LEN    (XML_RESP_LEN - XML_BODY_OFF)
+
+static_assert(XML_BODY_LEN < 1000, "XML_LEN_W too small for the XML length");
+static_assert(STREAM_PASS_SZ % TX_BUF_SZ == 0, "file blocks must divide an SD sector");
+
+#ifdef DEBUG_STATS
+// every call into the Ethernet library costs several SPI transactions
+// with the W5100, socketCalls counts those calls and writes counts the
+// writes, each of which is sent as its own TCP segment; fileReads
+// counts the File reads of responses sent from the SD card; minFreeRam
+// is the least free SRAM seen at the deepest point of the WebSocket
+// handshake, the largest stack frames of the sketch
+struct Stats {
+    unsigned long requests;
+    unsigned long socketCalls;
+    unsigned long writes;
+    unsigned long fileReads;
+    int minFreeRam;
+};
+Stats stats;
+#define STAT_ADD(field, n)  (stats.field += (n))
+#define STAT_RAM()          StatRam()
+#else
+#define STAT_ADD(field, n)
+#define STAT_RAM()
+#endif
+
+// collects the pieces of a response and passes them to the client in
+// blocks of up to TX_BUF_SZ bytes, sent when full or on flush()
+class TxWriter : public Print {
+public:
+    // starts collecting a response for client cl
+    void begin(EthernetClient &cl) {
+        client = &cl;
+        len = 0;
+    }
+
+    size_t write(uint8_t c) {
+        if (len == TX_BUF_SZ) {
+            flush();
+        }
+        buf[len++] = c;
+        return 1;
+    }
+
+    size_t write(const uint8_t *data, size_t size) {
+        size_t left = size;
+
+        while (left) {
+            size_t n = TX_BUF_SZ - len;
+
+            if (n == 0) {
+                flush();
+                n = TX_BUF_SZ;
+            }
+            if (n > left) {
+                n = left;
+            }
+            memcpy(buf + len, data, n);
+            len += n;
+            data += n;
+            left -= n;
+        }
+        return size;
+    }
+
+    // the buffer, for a caller that fills it with a block of up to
+    // TX_BUF_SZ bytes itself and then sends it with send(), or uses it
+    // as scratch memory before begin()
+    byte *block() {
+        len = 0;
+        return buf;
+    }
+
+    void send(size_t n) {
+        len = n;
+        flush();
+    }
+
+    // sends what has been collected
+    void flush() {
+        if (len) {
+            client->write(buf, len);
+            STAT_ADD(socketCalls, 1);
+            STAT_ADD(writes, 1);
+            len = 0;
+        }
+    }
+
+private:
+    EthernetClient *client;
+    alignas(uint32_t) byte buf[TX_BUF_SZ];
+    unsigned int len;
+};
+
+// connections
+void ConnOpen(EthernetClient &client);
+void ConnClose(Conn *conn);
+void ConnDrop(Conn *conn, byte reason);
+void ConnStage(Conn *conn, byte stage);
+boolean ConnExpired(Conn *conn);
+boolean ConnIdle(Conn *conn);
+byte ConnParked(void);
+boolean ConnRoom(Conn *conn, int n);
+void ConnService(Conn *conn);
+void Respond(Conn *conn);
+void ResponseDone(Conn *conn);
+void ConnReserve(void);
+void EventsPush(void);
+void StreamFile(Conn *conn);
+void FillState(Conn *conn, byte *buf, int n);
+boolean ConnSending(Conn *conn);
+int RxFill(RxRing *ring, EthernetClient &cl);
+#ifdef DEBUG_STATS
+void PrintStats(void);
+int FreeRam(void);
+void StatRam(void);
+#endif
+
+// responses
+void Dispatch(Conn *conn);
+void SendHeader(Conn *conn, const __FlashStringHelper *status,
+                const __FlashStringHelper *type, unsigned long length,
+                char etagKind);
+void SendHeaderStart(Conn *conn, const __FlashStringHelper *status,
+                     const __FlashStringHelper *type, unsigned long length,
+                     char etagKind);
+void SendHeaderEnd(Conn *conn);
+void SendStatus(Conn *conn, const __FlashStringHelper *status);
+boolean SubscribeRefused(Conn *conn);
+void SendPage(Conn *conn);
+void SendFavicon(Conn *conn);
+void SendButtonState(Conn *conn);
+void SendState(Conn *conn);
+char *StateBody(char *p, boolean json);
+void SendEvents(Conn *conn);
+byte RelayMask(void);
+void SetRELAYs(HttpRequest *req);
+void SetRELAY(byte i, boolean on);
+void SampleTemp(void);
+void XML_init(void);
+void XML_update(void);
+void XML_field(unsigned int offset, byte width, PGM_P text);
+void PutDigits(char *p, byte width, unsigned long value);
+boolean NotModified(Conn *conn, char kind);
+boolean ETagMatch(HttpRequest *req, char kind, unsigned long value);
+void PutETag(char kind, unsigned long value);
+
+// file cache
+void FileScan(void);
+FileInfo *FileFind(uint16_t hash);
+boolean SendFile(Conn *conn, const char *path, uint16_t hash);
+void SendCardFile(Conn *conn, FileInfo *info, const char *path);
+boolean GzSibling(const char *path, byte len, char *gzPath);
+void SendBundled(Conn *conn, const BundleFile *file, const char *path);
+const BundleFile *BundleFind(const char *path, uint16_t hash);
+void PutCacheControl(uint16_t hash, const char *path);
+boolean HashedName(const char *path);
+const __FlashStringHelper *FileType(const char *path);
+
+// WebSocket
+void SendWebSocket(Conn *conn);
+boolean WsParse(Conn *conn, byte c);
+void WsFrameEnd(Conn *conn);
+boolean WsSend(Conn *conn, byte opcode, const byte *data, byte len);
+void WsKeyChar(HttpRequest *req, char c);
+
+// SHA-1 and base64, for the WebSocket handshake only
+struct Sha1 {
+    union {
+        byte b[64];             // message block
+        uint32_t w[16];         // message schedule, in place
+    };
+    uint32_t h[5];
+    byte len;                   // bytes in the block
+    unsigned long total;        // bytes hashed
+};
+uint32_t Rol(uint32_t x, byte n);
+void Sha1Begin(Sha1 *sha);
+void Sha1Byte(Sha1 *sha, byte c);
+void Sha1Block(Sha1 *sha);
+void Sha1End(Sha1 *sha, byte *digest);
+void Base64(const byte *data, byte len, Print &out);
+
+// SendWebSocket() hashes in the tx buffer and leaves the digest in wsKey
+static_assert(sizeof(Sha1) <= TX_BUF_SZ, "the SHA-1 state must fit the tx buffer");
+static_assert(SHA1_DIGEST_SZ <= WS_KEY_LEN, "the SHA-1 digest must fit wsKey");
+
+// request parser
+void RequestBegin(HttpRequest *req);
+byte RequestParse(HttpRequest *req, char c);
+char StrAppend(char *buf, byte *len, byte size, char c);
+void RelayMatch(HttpRequest *req, char c);
+void WaitMatch(HttpRequest *req, char c);
+void QueryParam(HttpRequest *req);
+char ToLower(char c);
+byte HeaderId(uint16_t hash);
+void HeaderToken(HttpRequest *req);
+void ETagChar(HttpRequest *req, char c);
+
 Thermistor temp(2);
 
 // MAC address from Ethernet shield sticker under board
@@ -61,28 +688,114 @@ byte mac[] = { 0xDE, 0xAD, 0xBE, 0xEF, 0xFE, 0xED };
 IPAddress ip(192, 168, 0, 120);
 // create a server at port 80
 EthernetServer server(80);
-// the web page file on the SD card
-File webFile;
-// buffered HTTP request stored as null terminated string
-char HTTP_req[REQ_BUF_SZ] = {0};
-// index into HTTP_req buffer
-char req_index = 0;
+// client connections, each one parses and answers on its own
+Conn conns[MAX_SOCK_NUM];
+// response being generated, one connection at a time
+TxWriter tx;
+// time allowed in each stage of a connection
+const unsigned int STAGE_MS[] PROGMEM = {
+    KEEP_ALIVE_MS, HEADER_MS, DRAIN_MS, DRAIN_MS, LONG_POLL_MS,
+    EVENT_PING_MS, EVENT_PING_MS
+};
+// number of connections dropped for each DROP_ reason
+unsigned int drops[DROP_NUM] = {0};
+// millis() at which ConnReserve() last asked a busy connection to close
+unsigned long reserveAt;
 // stores the states of the RELAYs
 boolean RELAY_state[BTN_NUM] = {0};
+// output pin of each RELAY
+// Living Room, Master Bed, Guest Room, Kitchen, Wash Room
+const byte RELAY_pin[BTN_NUM] PROGMEM = { 5, 6, 9, 8, 7 };
+// name of the relay command parameters, followed by the relay number
+const char RELAY_KEY[] PROGMEM = "RELAY";
+// request method and protocol version the parser recognizes
+const char METHOD_GET_STR[] PROGMEM = "GET";
+const char HTTP_VERSION[] PROGMEM = "HTTP/1.1";
+// files of the SD card root
+FileInfo files[FILE_NUM];
+byte fileNum;
+// Content-Type of the files served, by file name extension
+const char TYPE_HTML[] PROGMEM = "text/html";
+const char TYPE_CSS[] PROGMEM  = "text/css";
+const char TYPE_JS[] PROGMEM   = "application/javascript";
+const char TYPE_TEXT[] PROGMEM = "text/plain";
+const char TYPE_XML[] PROGMEM  = "text/xml";
+const char TYPE_ICO[] PROGMEM  = "image/x-icon";
+const char TYPE_PNG[] PROGMEM  = "image/png";
+const char TYPE_JPG[] PROGMEM  = "image/jpeg";
+const char TYPE_SVG[] PROGMEM  = "image/svg+xml";
+const char TYPE_OTHER[] PROGMEM = "application/octet-stream";
+const MimeType MIME_TYPES[] PROGMEM = {
+    { "htm", TYPE_HTML },
+    { "css", TYPE_CSS },
+    { "js",  TYPE_JS },
+    { "txt", TYPE_TEXT },
+    { "xml", TYPE_XML },
+    { "ico", TYPE_ICO },
+    { "png", TYPE_PNG },
+    { "jpg", TYPE_JPG },
+    { "svg", TYPE_SVG },
+};
+#define MIME_TYPE_NUM   (sizeof(MIME_TYPES) / sizeof(MIME_TYPES[0]))
+// Sec-WebSocket-Key of the handshake being received, one at a time,
+// so the connections do not each need room for it
+char wsKey[WS_KEY_LEN];
+byte wsKeyLen;
+HttpRequest *wsKeyOwner;
+// appended to the key before hashing, from RFC 6455
+const char WS_GUID[] PROGMEM = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+// last temperature sampled, in degrees Celsius
+int celsius;
+// incremented whenever a RELAY or the temperature changes, sent as ETag
+unsigned long stateVersion = 1;
+// millis() of the last temperature sample
+unsigned long tempSampled;
+// pre-rendered button_state response
+char XML_resp[XML_RESP_LEN];
+// values currently written into XML_resp
+unsigned long XML_version;
+int XML_celsius;
+boolean XML_relay[BTN_NUM];
+// contents of the fields of XML_resp
+const char XML_KEEP_ALIVE[] PROGMEM = "keep-alive";
+const char XML_CLOSE[] PROGMEM      = "close     ";
+const char XML_ON[] PROGMEM         = "on</BUTTON> \r\n";
+const char XML_OFF[] PROGMEM        = "off</BUTTON>\r\n";
+const char XML_TEMP_END[] PROGMEM   = "</temp>";
+
+static_assert(XML_RESP_LEN <= RESPONSE_ROOM,
+              "button_state response must fit RESPONSE_ROOM");
+static_assert(SLEN(XML_KEEP_ALIVE) == XML_CONN_W && SLEN(XML_CLOSE) == XML_CONN_W,
+              "Connection values must fill XML_CONN_W");
+static_assert(SLEN(XML_ON) == XML_STATE_W && SLEN(XML_OFF) == XML_STATE_W,
+              "button values must fill XML_STATE_W");
+
+// RELAY values filled into the pages
+const char FILL_ON[] PROGMEM  = "ON ";
+const char FILL_OFF[] PROGMEM = "OFF";
+
+static_assert(SLEN(FILL_ON) == FILL_RELAY_W && SLEN(FILL_OFF) == FILL_RELAY_W,
+              "RELAY values must fill FILL_RELAY_W");
 
 void setup() {
+    char path[sizeof(PATH_INDEX)];
+
     // disable Ethernet chip
     pinMode(10, OUTPUT);
     digitalWrite(10, HIGH);
 
     Serial.begin(9600);       // for debugging
 
+    // the bundled files are served without the card
     if (!SD.begin(4)) {
-        Serial.println("ERROR - SD card initialization failed!");
-        return;    // init failed
+        Serial.println(F("ERROR - SD card initialization failed!"));
     }
-    if (!SD.exists("index.htm")) {
-        Serial.println("ERROR - Can't find index.htm file!");
+    else {
+        FileScan();
+    }
+    strcpy_P(path, PATH_INDEX);
+    if (!BundleFind(path, HASH_INDEX) && !FileFind(HASH_INDEX)) {
+        Serial.println(F("ERROR - Can't find index.htm file!"));
         return;  // can't find index file
     }
 
@@ -93,197 +806,1811 @@ void setup() {
     pinMode(8, OUTPUT);
     pinMode(9, OUTPUT);
 
+    celsius = temp.getTemp();
+    tempSampled = millis();
+    XML_init();
+
     Ethernet.begin(mac, ip);  // initialize Ethernet device
     server.begin();           // start to listen for clients
+
+#ifdef DEBUG_STATS
+    Serial.print(F("free SRAM: "));
+    Serial.println(FreeRam());
+#endif
 }
 
 void loop() {
-    EthernetClient client = server.available();  // try to get client
+    EthernetClient client = server.accept();  // new client connected?
+
+    if (client) {
+        ConnOpen(client);
+    }
+    // every open connection makes progress on every pass
+    for (byte i = 0; i < MAX_SOCK_NUM; i++) {
+        if (conns[i].inUse) {
+            ConnService(&conns[i]);
+        }
+    }
+    ConnReserve();
+    SampleTemp();
+    EventsPush();
+}
 
-    if (client) {  // got client?
-        boolean currentLineIsBlank = true;
+// starts serving a newly connected client
+void ConnOpen(EthernetClient &client) {
+    Conn *conn = &conns[client.getSocketNumber()];
 
-        while (client.connected()) {
-            if (client.available()) {   // client data available to read
-                char c = client.read(); // read 1 byte (character) from client
-                // limit the size of the stored received HTTP request
-                // buffer first part of HTTP request in HTTP_req array (string)
-                // leave last element in array as 0 to null terminate string (REQ_BUF_SZ - 1)
+    // the socket may have been reused before the old connection
+    // was noticed to be closed
+    if (conn->file) {
+        conn->file.close();
+    }
+    conn->flashLeft = 0;
+    conn->inUse = true;
+    conn->client = client;
+    conn->client.setConnectionTimeout(CLOSE_MS);
+    conn->rx.head = 0;
+    conn->rx.tail = 0;
+    conn->requests = 0;
+    conn->closeNext = false;
+    // the first request has to arrive within HEADER_MS of connecting
+    ConnStage(conn, ST_HEADER);
+    RequestBegin(&conn->req);
+}
 
-                if (req_index < (REQ_BUF_SZ - 1)) {
-                    HTTP_req[req_index] = c;          // save HTTP request character
-                    req_index++;
-                }
-                // last line of client request is blank and ends with \n
-                // respond to client only after last line received
-
-                if (c == '\n' && currentLineIsBlank) {
-                    // send a standard http response header
-                    client.println("HTTP/1.1 200 OK");
-                    // remainder of header follows below, depending on if
-                    // web page or XML page is requested
-                    // Ajax request - send XML file
-
-                    if (StrContains(HTTP_req, "button_state")) {
-                        // send rest of HTTP header
-                        client.println("Content-Type: text/xml");
-                        client.println("Connection: keep-alive");
-                        client.println();
-                        SetRELAYs();
-                        // send XML file containing input states
-                        XML_response(client);
-                    }
-
-                    else {  // web page request
-                        // send rest of HTTP header
-                        client.println("Content-Type: text/html");
-                        client.println("Connection: keep-alive");
-                        client.println();
-                        // send web page
-                        webFile = SD.open("index.htm");        // open web page file
-
-                        if (webFile) {
-                            while(webFile.available()) {
-                                client.write(webFile.read()); // send web page to client
-                            }
-                            webFile.close();
-                        }
-                    }
-                    // reset buffer index and all buffer elements to 0
-                    req_index = 0;
-                    StrClear(HTTP_req, REQ_BUF_SZ);
-                    break;
-                }
-                // every line of text received from the client ends with \r\n
+// closes the connection and frees its slot
+void ConnClose(Conn *conn) {
+    if (conn->file) {
+        conn->file.close();
+    }
+    // a handshake cut off mid-request would hold wsKey until the slot
+    // is used again, failing every other handshake until then
+    if (wsKeyOwner == &conn->req) {
+        wsKeyOwner = NULL;
+    }
+    conn->flashLeft = 0;
+    conn->client.stop();
+    conn->inUse = false;
+}
 
-                if (c == '\n') {
-                    // last character on line of received text
-                    // starting new line with next character read
-                    currentLineIsBlank = true;
-                }
-                else if (c != '\r') {
-                    // a text character was received from client
-                    currentLineIsBlank = false;
-                }
-            } // end if (client.available())
-        } // end while (client.connected())
-        delay(1);      // give the web browser time to receive the data
-        client.stop(); // close the connection
-    } // end if (client)
+// closes a connection the server gave up on for reason
+void ConnDrop(Conn *conn, byte reason) {
+    drops[reason]++;
+    ConnClose(conn);
 }
 
-// checks if received HTTP request is switching on/off RELAYs
-// also saves the state of the RELAYs
-void SetRELAYs(void) {
-    // Living Room (pin 5)
-    if (StrContains(HTTP_req, "RELAY1=1")) {
-        RELAY_state[0] = 1;         // save Switch 1 state to On
-        digitalWrite(5, HIGH);
+// moves the connection to stage and starts the deadline of the stage
+// also called to restart the deadline when a stage makes progress
+void ConnStage(Conn *conn, byte stage) {
+    conn->stage = stage;
+    conn->deadline = millis() + pgm_read_word(&STAGE_MS[stage]);
+}
+
+// true if the deadline of the current stage has passed
+boolean ConnExpired(Conn *conn) {
+    return (long)(millis() - conn->deadline) >= 0;
+}
+
+// true if the connection waits for a request that has not started
+boolean ConnIdle(Conn *conn) {
+    return conn->stage == ST_IDLE && conn->rx.tail == conn->rx.head;
+}
+
+// number of connections parked in ST_WAIT or later
+byte ConnParked(void) {
+    byte n = 0;
+
+    for (byte i = 0; i < MAX_SOCK_NUM; i++) {
+        if (conns[i].inUse && conns[i].stage >= ST_WAIT) {
+            n++;
+        }
+    }
+    return n;
+}
+
+// true if the socket of conn has room for n more bytes
+boolean ConnRoom(Conn *conn, int n) {
+    STAT_ADD(socketCalls, 1);
+    return conn->client.availableForWrite() >= n;
+}
+
+// does one step of work on the connection without waiting: receive and
+// parse what has arrived, or send the next block of the response
+void ConnService(Conn *conn) {
+    STAT_ADD(socketCalls, 1);  // connected()
+    if (!conn->client.connected()) {
+        ConnClose(conn);
+        return;
+    }
+
+    if (ConnSending(conn)) {
+        StreamFile(conn);
+        if (!ConnSending(conn)) {
+            ResponseDone(conn);
+        }
+        else if (ConnExpired(conn)) {
+            ConnDrop(conn, DROP_DRAIN);
+        }
+        return;
+    }
+
+    // closed once the client has acknowledged the whole response, the
+    // short wait of stop() then only covers the close itself
+    if (conn->stage == ST_CLOSE) {
+        STAT_ADD(socketCalls, 1);
+        if (conn->client.availableForWrite() == SOCK_TX_SZ) {
+            ConnClose(conn);
+        }
+        else if (ConnExpired(conn)) {
+            ConnDrop(conn, DROP_DRAIN);
+        }
+        return;
+    }
+
+    // a parked long-poll is answered once the state has changed, or
+    // with the unchanged state when it has waited for LONG_POLL_MS
+    if (conn->stage == ST_WAIT) {
+        if (conn->req.waitVersion != stateVersion || ConnExpired(conn)) {
+            conn->req.longPoll = false;
+            Respond(conn);
+        }
+        return;
+    }
+
+    // events are written by EventsPush(), a quiet stream gets a comment
+    // line now and then so that a dead client is eventually noticed; a
+    // client that has not even taken the last one is dropped
+    if (conn->stage == ST_STREAM) {
+        if (ConnExpired(conn)) {
+            if (!ConnRoom(conn, 3)) {
+                ConnDrop(conn, DROP_DRAIN);
+                return;
+            }
+            conn->client.write((const uint8_t *)":\n\n", 3);
+            STAT_ADD(socketCalls, 1);
+            STAT_ADD(writes, 1);
+            ConnStage(conn, ST_STREAM);
+        }
+        return;
     }
-    else if (StrContains(HTTP_req, "RELAY1=0")) {
-        RELAY_state[0] = 0;     // save Switch 1 state to OFF
-        digitalWrite(5, LOW);
+
+    // frames are parsed as they arrive, a quiet socket is pinged
+    if (conn->stage == ST_WEBSOCKET) {
+        RxFill(&conn->rx, conn->client);
+        while (conn->rx.tail != conn->rx.head) {
+            if (!WsParse(conn, conn->rx.buf[conn->rx.tail++ & (RX_BUF_SZ - 1)])) {
+                ConnClose(conn);
+                return;
+            }
+        }
+        if (ConnExpired(conn)) {
+            if (!WsSend(conn, WS_OP_PING, NULL, 0)) {
+                ConnDrop(conn, DROP_DRAIN);
+                return;
+            }
+            ConnStage(conn, ST_WEBSOCKET);
+        }
+        return;
     }
 
-    // Master Bed (pin 6)
-    if (StrContains(HTTP_req, "RELAY2=1")) {
-        RELAY_state[1] = 1;         // save Switch 2 state to On
-        digitalWrite(6, HIGH);
+    // read a block of bytes from client
+    if (RxFill(&conn->rx, conn->client) && conn->stage == ST_IDLE) {
+        ConnStage(conn, ST_HEADER);     // next request started
     }
-    else if (StrContains(HTTP_req, "RELAY2=0")) {
-        RELAY_state[1] = 0;     // save Switch 2 state to Off
-        digitalWrite(6, LOW);
+
+    // a complete request may still wait for room to be answered, the
+    // bytes after it belong to the next request
+    while (conn->req.state != PS_DONE && conn->rx.tail != conn->rx.head) {
+        char c = conn->rx.buf[conn->rx.tail++ & (RX_BUF_SZ - 1)];
+
+        // respond to client only after the blank line that
+        // ends the request header has been received
+        if (RequestParse(&conn->req, c) == PS_DONE) {
+            break;
+        }
     }
 
-    // Guest Room (pin 9)
-    if (StrContains(HTTP_req, "RELAY3=1")) {
-        RELAY_state[2] = 1;         // save Switch 3 state to On
-        digitalWrite(9, HIGH);
+    if (conn->req.state == PS_DONE) {
+        Respond(conn);
     }
-    else if (StrContains(HTTP_req, "RELAY3=0")) {
-        RELAY_state[2] = 0;     // save Switch 3 state to Off
-        digitalWrite(9, LOW);
+    else if (ConnExpired(conn)) {
+        // idle for too long, or a request trickling in too slowly
+        ConnDrop(conn, conn->stage);
     }
+}
 
-    // Kitchen (pin 7)
-    if (StrContains(HTTP_req, "RELAY4=1")) {
-        RELAY_state[3] = 1;         // save Switch 4 state to On
-        digitalWrite(8, HIGH);
+// answers the complete request of conn, unless the handler parked it
+// as a long-poll or an event stream, or left a file to be sent
+// without RESPONSE_ROOM in the socket, the request waits in ST_DRAIN
+// and ConnService() calls back on the next pass
+void Respond(Conn *conn) {
+    if (!ConnRoom(conn, RESPONSE_ROOM)) {
+        if (conn->stage != ST_DRAIN) {
+            ConnStage(conn, ST_DRAIN);
+        }
+        else if (ConnExpired(conn)) {
+            ConnDrop(conn, DROP_DRAIN);
+        }
+        return;
     }
-    else if (StrContains(HTTP_req, "RELAY4=0")) {
-        RELAY_state[3] = 0;     // save Switch 4 state to Off
-        digitalWrite(8, LOW);
+    ConnStage(conn, ST_DRAIN);
+    Dispatch(conn);
+    if (!ConnSending(conn) && conn->stage == ST_DRAIN) {
+        ResponseDone(conn);
     }
+}
 
-    // Wash Room (pin 9)
-    if (StrContains(HTTP_req, "RELAY5=1")) {
-        RELAY_state[4] = 1;         // save Switch 5 state to On
-        digitalWrite(7, HIGH);
+// called when the response to the request of conn has been sent
+void ResponseDone(Conn *conn) {
+#ifdef DEBUG_STATS
+    PrintStats();
+#endif
+    if (conn->requests < 255) {
+        conn->requests++;
     }
-    else if (StrContains(HTTP_req, "RELAY5=0")) {
-        RELAY_state[4] = 0;     // save Switch 5 state to Off
-        digitalWrite(7, LOW);
+    if (!conn->req.keepAlive) {
+        ConnStage(conn, ST_CLOSE);
+        return;
     }
+    // wait on the same connection for the next request,
+    // bytes of it may already be in rx
+    RequestBegin(&conn->req);
+    ConnStage(conn, ST_IDLE);
 }
 
-// send the XML file with Temperature and Switch status
-void XML_response(EthernetClient cl) {
-    byte celsius = temp.getTemp();
+// the server can only accept a client while a socket is free, when
+// all are in use the kept-alive connection idle for longest is closed,
+// or failing that the oldest long-poll is answered and closed, either
+// only once it has waited for RESERVE_IDLE_MS; with every connection
+// busy, the one with most requests answers its next one with
+// Connection: close, one every RESERVE_IDLE_MS at most; event
+// streams and WebSockets are never closed for a newcomer, there are
+// at most PARKED_MAX of them, see SubscribeRefused()
+void ConnReserve(void) {
+    Conn *oldest = NULL;
+    Conn *parked = NULL;
+    Conn *busiest = NULL;
+    boolean rotating = false;
+
+    for (byte i = 0; i < MAX_SOCK_NUM; i++) {
+        Conn *conn = &conns[i];
+
+        // a closing connection frees its socket soon
+        if (!conn->inUse || conn->stage == ST_CLOSE) {
+            return;
+        }
+        if (conn->closeNext) {
+            rotating = true;
+        }
+        else if (conn->stage < ST_WAIT &&
+                (!busiest || conn->requests > busiest->requests)) {
+            busiest = conn;
+        }
+        if (millis() - (conn->deadline - pgm_read_word(&STAGE_MS[conn->stage])) <
+                RESERVE_IDLE_MS) {
+            continue;
+        }
+        if (conn->requests > 0 && ConnIdle(conn) &&
+                (!oldest || (long)(conn->deadline - oldest->deadline) < 0)) {
+            oldest = conn;
+        }
+        if (conn->stage == ST_WAIT &&
+                (!parked || (long)(conn->deadline - parked->deadline) < 0)) {
+            parked = conn;
+        }
+    }
+    if (oldest) {
+        ConnDrop(oldest, DROP_RESERVE);
+    }
+    else if (parked) {
+        // the client polls again right away, on a new connection
+        parked->req.longPoll = false;
+        parked->req.keepAlive = false;
+        Respond(parked);
+    }
+    else if (busiest && !rotating && millis() - reserveAt >= RESERVE_IDLE_MS) {
+        busiest->closeNext = true;
+        reserveAt = millis();
+    }
+}
 
-    cl.print("<?xml version = \"1.0\" ?>");
-    cl.print("<inputs>");
+// sends the current state to every /events subscriber and WebSocket
+// that has not had it yet; the event is serialized once, and the same
+// bytes are written to each socket with room for them, a subscriber
+// without room gets the state of a later pass instead
+void EventsPush(void) {
+    char ev[EVENT_BUF_SZ];
+    byte len = 0;
+    byte frame[5];
 
-        cl.print("<temp>");
-        cl.print(celsius);
-        cl.print("</temp>");
+    for (byte i = 0; i < MAX_SOCK_NUM; i++) {
+        Conn *conn = &conns[i];
 
-        for(int i = 0; i < BTN_NUM; i++) {
-            cl.print("<BUTTON>");
-            if (RELAY_state[i]) {
-                cl.print("on");
+        if (!conn->inUse) {
+            continue;
+        }
+        if (conn->stage == ST_WEBSOCKET) {
+            if (conn->ws.sentVersion == stateVersion) {
+                continue;
             }
-            else {
-                cl.print("off");
+            // RELAY bitmask and temperature, little endian
+            frame[0] = WS_FIN | WS_OP_BINARY;
+            frame[1] = 3;
+            frame[2] = RelayMask();
+            frame[3] = celsius & 0xFF;
+            frame[4] = (celsius >> 8) & 0xFF;
+            STAT_ADD(socketCalls, 1);
+            if (conn->client.availableForWrite() >= (int)sizeof(frame)) {
+                conn->client.write(frame, sizeof(frame));
+                STAT_ADD(socketCalls, 1);
+                STAT_ADD(writes, 1);
+                conn->ws.sentVersion = stateVersion;
+                ConnStage(conn, ST_WEBSOCKET);
             }
-            cl.println("</BUTTON>");
+            continue;
+        }
+        if (conn->stage != ST_STREAM ||
+                conn->req.waitVersion == stateVersion) {
+            continue;
         }
+        if (len == 0) {
+            // id: <version>\ndata: <json>\n\n
+            char *p = ev;
 
-    cl.print("</inputs>");
+            strcpy_P(p, PSTR("id: "));
+            p += strlen(p);
+            ultoa(stateVersion, p, 10);
+            p += strlen(p);
+            strcpy_P(p, PSTR("\ndata: "));
+            p = StateBody(p + strlen(p), true);
+            *p++ = '\n';
+            *p++ = '\n';
+            len = p - ev;
+        }
+        STAT_ADD(socketCalls, 1);
+        if (conn->client.availableForWrite() >= len) {
+            conn->client.write((const uint8_t *)ev, len);
+            STAT_ADD(socketCalls, 1);
+            STAT_ADD(writes, 1);
+            conn->req.waitVersion = stateVersion;
+            ConnStage(conn, ST_STREAM);
+        }
+    }
 }
 
-// sets every element of str to 0 (clears array)
-void StrClear(char *str, char length) {
-    for (int i = 0; i < length; i++) {
-        str[i] = 0;
-    }
+// true while a file is being sent on conn
+boolean ConnSending(Conn *conn) {
+    return conn->flashLeft || conn->file;
 }
 
-// searches for the string sfind in the string str
-// returns 1 if string found
-// returns 0 if string not found
-char StrContains(char *str, char *sfind) {
-    char found = 0;
-    char index = 0;
-    char len;
+// sends the next blocks of the file being sent on conn, as many as the
+// socket has room for, up to STREAM_PASS_SZ bytes; closes the file
+// after its last block
+// the blocks are read into the buffer of tx, so they cost no extra
+// SRAM; the W5100 sends the blocks it holds while the next ones are
+// read from the card, and the SD library reads each sector only once
+// since the blocks divide it
+void StreamFile(Conn *conn) {
+    int room;
 
-    len = strlen(str);
+    STAT_ADD(socketCalls, 1);
+    room = conn->client.availableForWrite();
+    if (room > STREAM_PASS_SZ) {
+        room = STREAM_PASS_SZ;
+    }
+    tx.begin(conn->client);
+    while (room >= TX_BUF_SZ && conn->flashLeft) {
+        unsigned int n = (conn->flashLeft < TX_BUF_SZ) ? conn->flashLeft : TX_BUF_SZ;
 
-    if (strlen(sfind) > len) {
-        return 0;
+        memcpy_P(tx.block(), conn->flash, n);
+        if (conn->fill) {
+            FillState(conn, tx.block(), n);
+        }
+        tx.send(n);
+        conn->flash += n;
+        conn->flashLeft -= n;
+        ConnStage(conn, ST_DRAIN);
+        room -= TX_BUF_SZ;
     }
-    while (index < len) {
-        if (str[index] == sfind[found]) {
-            found++;
+    while (room >= TX_BUF_SZ && conn->file) {
+        int n = conn->file.read(tx.block(), TX_BUF_SZ);
 
-            if (strlen(sfind) == found) {
-                return 1;
+        STAT_ADD(fileReads, 1);
+        if (n > 0) {
+            if (conn->fill) {
+                FillState(conn, tx.block(), n);
             }
+            tx.send(n);
+            ConnStage(conn, ST_DRAIN);  // client is making progress
+        }
+        if (n < TX_BUF_SZ) {
+            conn->file.close();
+            return;
+        }
+        room -= TX_BUF_SZ;
+    }
+}
+
+// replaces the FILL_ placeholders in the n bytes of a page at buf
+// with the state; the bytes keep their number, so the Content-Length
+// of the file holds, and conn->fillPos lets a placeholder span blocks
+void FillState(Conn *conn, byte *buf, int n) {
+    char digits[8];
+
+    for (int i = 0; i < n; i++) {
+        byte c = buf[i];
+        byte pos = conn->fillPos;
+        byte width;
+
+        if (c == FILL_TEMP) {
+            itoa(celsius, digits, 10);
+            buf[i] = (pos < strlen(digits)) ? digits[pos] : ' ';
+            width = FILL_TEMP_W;
+        }
+        else if (c >= FILL_RELAY && c < FILL_RELAY + BTN_NUM) {
+            buf[i] = pgm_read_byte((RELAY_state[c - FILL_RELAY] ? FILL_ON : FILL_OFF) + pos);
+            width = FILL_RELAY_W;
         }
         else {
-            found = 0;
+            continue;
         }
-        index++;
+        conn->fillPos = (pos + 1 == width) ? 0 : pos + 1;
     }
+}
 
-    return 0;
+// the route table, in flash
+constexpr Route ROUTES[] PROGMEM = {
+    { PathHash(PATH_ROOT),          METHOD_GET, PATH_ROOT,          SendPage },
+    { PathHash(PATH_INDEX),         METHOD_GET, PATH_INDEX,         SendPage },
+    { PathHash(PATH_BUTTON_STATE),  METHOD_GET, PATH_BUTTON_STATE,  SendButtonState },
+    { PathHash(PATH_STATE),         METHOD_GET, PATH_STATE,         SendState },
+    { PathHash(PATH_STATE_JSON),    METHOD_GET, PATH_STATE_JSON,    SendState },
+    { PathHash(PATH_EVENTS),        METHOD_GET, PATH_EVENTS,        SendEvents },
+    { PathHash(PATH_WS),            METHOD_GET, PATH_WS,            SendWebSocket },
+    { PathHash(PATH_FAVICON),       METHOD_GET, PATH_FAVICON,       SendFavicon },
+};
+#define ROUTE_NUM   (sizeof(ROUTES) / sizeof(ROUTES[0]))
+
+// true if no two routes from i on have the same path hash, so a hash
+// compare selects at most one route
+constexpr bool RouteHashesUnique(byte i, byte j) {
+    return i >= ROUTE_NUM ? true :
+           j >= ROUTE_NUM ? RouteHashesUnique(i + 1, i + 2) :
+           ROUTES[i].hash != ROUTES[j].hash && RouteHashesUnique(i, j + 1);
+}
+static_assert(RouteHashesUnique(0, 1), "route path hashes collide, change a path or PathHash()");
+
+// sends the response to a complete request
+// the route is selected by the path hash, one string compare confirms it
+void Dispatch(Conn *conn) {
+    HttpRequest *req = &conn->req;
+
+    // request bodies are never read, so after a request that may have
+    // one the connection cannot be used for the next request
+    if (req->method != METHOD_GET) {
+        req->keepAlive = false;
+    }
+    // with PARKED_MAX connections parked the last socket is not held
+    // by keep-alive, the next client needs it; nor is the socket that
+    // ConnReserve() picked to give a waiting client a turn
+    if (ConnParked() >= PARKED_MAX || conn->closeNext) {
+        req->keepAlive = false;
+    }
+
+    if (!req->pathTooLong) {
+        for (byte i = 0; i < ROUTE_NUM; i++) {
+            const Route *route = &ROUTES[i];
+
+            if (pgm_read_word(&route->hash) == req->pathHash &&
+                    strcmp_P(req->path, (PGM_P)pgm_read_ptr(&route->path)) == 0) {
+                if (pgm_read_byte(&route->method) == req->method) {
+                    ((RouteHandler)pgm_read_ptr(&route->handler))(conn);
+                }
+                else {
+                    SendStatus(conn, F("405 Method Not Allowed"));
+                }
+                return;
+            }
+        }
+        // files of the bundle and of the card
+        if (req->method == METHOD_GET &&
+                SendFile(conn, req->path, req->pathHash)) {
+            return;
+        }
+    }
+    SendStatus(conn, F("404 Not Found"));
+}
+
+// starts the response with its header, the body of length bytes
+// follows through tx, which the caller flushes at the end
+// type may be NULL when there is no body, length NO_LENGTH for a 304
+// with etagKind other than 0 the response is validated by an ETag of
+// that kind and stateVersion, and has to be revalidated on every use
+void SendHeader(Conn *conn, const __FlashStringHelper *status,
+                const __FlashStringHelper *type, unsigned long length,
+                char etagKind) {
+    SendHeaderStart(conn, status, type, length, etagKind);
+    SendHeaderEnd(conn);
+}
+
+// the header lines of SendHeader() up to Connection, further lines
+// may follow before SendHeaderEnd()
+void SendHeaderStart(Conn *conn, const __FlashStringHelper *status,
+                     const __FlashStringHelper *type, unsigned long length,
+                     char etagKind) {
+    tx.begin(conn->client);
+    tx.print(F("HTTP/1.1 "));
+    tx.println(status);
+    if (type) {
+        tx.print(F("Content-Type: "));
+        tx.println(type);
+    }
+    if (length != NO_LENGTH) {
+        tx.print(F("Content-Length: "));
+        tx.println(length);
+    }
+    if (etagKind) {
+        tx.println(F("Cache-Control: no-cache"));
+        PutETag(etagKind, stateVersion);
+    }
+}
+
+// the ETag header line, a kind letter and value, in the same form as
+// the ETag in XML_resp
+void PutETag(char kind, unsigned long value) {
+    char digits[XML_ETAG_W];
+
+    PutDigits(digits, XML_ETAG_W, value);
+    tx.print(F("ETag: \""));
+    tx.write(kind);
+    tx.write((const uint8_t *)digits, XML_ETAG_W);
+    tx.println(F("\""));
+}
+
+// Connection and the blank line ending the header
+void SendHeaderEnd(Conn *conn) {
+    if (conn->req.keepAlive) {
+        tx.println(F("Connection: keep-alive"));
+    }
+    else {
+        tx.println(F("Connection: close"));
+    }
+    tx.println();
+}
+
+// sends a response without body
+void SendStatus(Conn *conn, const __FlashStringHelper *status) {
+    SendHeader(conn, status, NULL, 0, 0);
+    tx.flush();
+}
+
+// answers a request that would park the connection with 503 if
+// PARKED_MAX connections are parked already, and closes it; the page
+// then falls back to polling; returns true if it was refused
+boolean SubscribeRefused(Conn *conn) {
+    if (ConnParked() < PARKED_MAX) {
+        return false;
+    }
+    conn->req.keepAlive = false;
+    SendHeaderStart(conn, F("503 Service Unavailable"), NULL, 0, 0);
+    tx.print(F("Retry-After: "));
+    tx.println(RETRY_AFTER_S);
+    SendHeaderEnd(conn);
+    tx.flush();
+    return true;
+}
+
+// sends the header of the web page, loop() then sends the file
+// the path of the request is done with, it takes the path of the page
+void SendPage(Conn *conn) {
+    strcpy_P(conn->req.path, PATH_INDEX);
+    if (!SendFile(conn, conn->req.path, HASH_INDEX)) {
+        SendStatus(conn, F("404 Not Found"));
+    }
+}
+
+// sends the header of the file at path with PathHash() hash, loop()
+// then sends the file; bundled files are sent from flash, other files
+// and compressed bundled files for clients that do not accept gzip
+// from the card; returns false if there is no such file
+boolean SendFile(Conn *conn, const char *path, uint16_t hash) {
+    const BundleFile *bundled = BundleFind(path, hash);
+    FileInfo *info;
+
+    if (bundled && (!pgm_read_byte(&bundled->gzip) || conn->req.acceptGzip)) {
+        SendBundled(conn, bundled, path);
+        return true;
+    }
+    info = FileFind(hash);
+    if (!info) {
+        return false;
+    }
+    SendCardFile(conn, info, path);
+    return true;
+}
+
+// browsers ask for /favicon.ico by themselves; unless the bundle or
+// the card has one, they get an empty 204 they may cache for
+// FAVICON_MAX_AGE, where a 404 would be asked again on every visit
+void SendFavicon(Conn *conn) {
+    if (SendFile(conn, conn->req.path, conn->req.pathHash)) {
+        return;
+    }
+    SendHeaderStart(conn, F("204 No Content"), NULL, NO_LENGTH, 0);
+    tx.print(F("Cache-Control: max-age="));
+    tx.println(FAVICON_MAX_AGE);
+    SendHeaderEnd(conn);
+    tx.flush();
+}
+
+// sends the header of a bundled file, the ETag is computed by
+// tools/build_site.py, a client that has it gets a 304
+// the state is filled into an uncompressed page, so its ETag also
+// changes with stateVersion
+void SendBundled(Conn *conn, const BundleFile *file, const char *path) {
+    const __FlashStringHelper *type = FileType(path);
+    unsigned long tag = pgm_read_dword(&file->etag);
+    unsigned int size = pgm_read_word(&file->size);
+    boolean gzip = pgm_read_byte(&file->gzip);
+    boolean fill = !gzip && type == (const __FlashStringHelper *)TYPE_HTML;
+    boolean modified;
+
+    if (fill) {
+        tag ^= stateVersion;
+    }
+    modified = !ETagMatch(&conn->req, 'b', tag);
+    if (modified) {
+        SendHeaderStart(conn, F("200 OK"), type, size, 0);
+        conn->flash = (const byte *)pgm_read_ptr(&file->data);
+        conn->flashLeft = size;
+        conn->fill = fill;
+        conn->fillPos = 0;
+    }
+    else {
+        SendHeaderStart(conn, F("304 Not Modified"), NULL, NO_LENGTH, 0);
+    }
+    PutETag('b', tag);
+    PutCacheControl(pgm_read_word(&file->hash), path);
+    if (gzip) {
+        tx.println(F("Vary: Accept-Encoding"));
+        if (modified) {
+            tx.println(F("Content-Encoding: gzip"));
+        }
+    }
+    SendHeaderEnd(conn);
+    tx.flush();
+}
+
+// the bundled file at path with PathHash() hash, NULL if none; the
+// hash selects it, one string compare confirms it, as in Dispatch()
+const BundleFile *BundleFind(const char *path, uint16_t hash) {
+    for (byte i = 0; i < BUNDLE_NUM; i++) {
+        if (pgm_read_word(&BUNDLE[i].hash) == hash &&
+                strcmp_P(path, (PGM_P)pgm_read_ptr(&BUNDLE[i].path)) == 0) {
+            return &BUNDLE[i];
+        }
+    }
+    return NULL;
+}
+
+// sends the header of a file of the card, loop() then sends the file
+// path is the path of the file from the request, its length comes
+// from the cache
+// a client that accepts gzip gets the compressed sibling of the file
+// if the card has one, the file name with its last character replaced
+// by 'z', sent as it is
+// the ETag is made of the cached size and content hash of the file
+// sent, kind 'f' for the file and 'g' for its sibling; a client that
+// has it gets a 304 and the file is not opened
+// files are found by path hash alone, so a file opened with a size
+// other than the cached one is not the file cached, it gets a 404
+// the state is filled into a page that is not compressed, its ETag
+// also changes with stateVersion
+void SendCardFile(Conn *conn, FileInfo *info, const char *path) {
+    const __FlashStringHelper *type = FileType(path);
+    char gzPath[PATH_BUF_SZ];
+    FileInfo *gzInfo = NULL;
+    FileInfo *sent = info;
+    byte len = strlen(path);
+    char kind = 'f';
+    unsigned long tag;
+    boolean fill;
+    boolean modified;
+
+    if (GzSibling(path, len, gzPath)) {
+        gzInfo = FileFind(PathHash(gzPath));
+    }
+    if (gzInfo && conn->req.acceptGzip) {
+        sent = gzInfo;
+        path = gzPath;
+        kind = 'g';
+    }
+    fill = sent == info && type == (const __FlashStringHelper *)TYPE_HTML;
+    tag = (sent->size << 16) | sent->contentHash;
+    if (fill) {
+        tag ^= stateVersion;
+    }
+    modified = !ETagMatch(&conn->req, kind, tag);
+    if (modified) {
+        conn->file = SD.open(path);
+        if (conn->file && conn->file.size() != sent->size) {
+            conn->file.close();
+        }
+        if (!conn->file) {
+            SendStatus(conn, F("404 Not Found"));
+            return;
+        }
+        conn->fill = fill;
+        conn->fillPos = 0;
+        SendHeaderStart(conn, F("200 OK"), type, sent->size, 0);
+    }
+    else {
+        SendHeaderStart(conn, F("304 Not Modified"), NULL, NO_LENGTH, 0);
+    }
+    PutETag(kind, tag);
+    PutCacheControl(info->hash, path);
+    if (gzInfo) {
+        // caches must keep the encodings apart
+        tx.println(F("Vary: Accept-Encoding"));
+        if (sent == gzInfo && modified) {
+            tx.println(F("Content-Encoding: gzip"));
+        }
+    }
+    SendHeaderEnd(conn);
+    tx.flush();
+}
+
+// writes the path of the compressed sibling of the file at path, of
+// length len, to gzPath; returns false if the file has none: a name
+// ending in 'z' would be its own sibling, and is sent as it is rather
+// than with Content-Encoding: gzip
+boolean GzSibling(const char *path, byte len, char *gzPath) {
+    if (len < 2 || path[len - 1] == 'z') {
+        return false;
+    }
+    strcpy(gzPath, path);
+    gzPath[len - 1] = 'z';
+    return true;
+}
+
+// Cache-Control max-age of files that differ from FILE_MAX_AGE
+constexpr CacheRule CACHE_RULES[] PROGMEM = {
+    { PathHash(PATH_INDEX), 0 },    // the entry point, always revalidated
+};
+#define CACHE_RULE_NUM  (sizeof(CACHE_RULES) / sizeof(CACHE_RULES[0]))
+
+// the Cache-Control header line of the file with PathHash() hash
+void PutCacheControl(uint16_t hash, const char *path) {
+    unsigned long maxAge = FILE_MAX_AGE;
+
+    if (HashedName(path)) {
+        tx.print(F("Cache-Control: max-age="));
+        tx.print(HASHED_MAX_AGE);
+        tx.println(F(", immutable"));
+        return;
+    }
+    for (byte i = 0; i < CACHE_RULE_NUM; i++) {
+        if (pgm_read_word(&CACHE_RULES[i].hash) == hash) {
+            maxAge = pgm_read_dword(&CACHE_RULES[i].maxAge);
+        }
+    }
+    if (maxAge == 0) {
+        tx.println(F("Cache-Control: no-cache"));
+    }
+    else {
+        tx.print(F("Cache-Control: max-age="));
+        tx.println(maxAge);
+    }
+}
+
+// true if the file name of path is HASHED_NAME_LEN lower case hex
+// digits and an extension
+boolean HashedName(const char *path) {
+    const char *name = strrchr(path, '/');
+    byte i;
+
+    name = name ? name + 1 : path;
+    for (i = 0; i < HASHED_NAME_LEN; i++) {
+        char c = name[i];
+
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return false;
+        }
+    }
+    return name[i] == '.';
+}
+
+// the Content-Type of a file, from the extension of its name
+const __FlashStringHelper *FileType(const char *path) {
+    const char *ext = strrchr(path, '.');
+
+    if (ext) {
+        for (byte i = 0; i < MIME_TYPE_NUM; i++) {
+            if (strcmp_P(ext + 1, MIME_TYPES[i].ext) == 0) {
+                return (const __FlashStringHelper *)pgm_read_ptr(&MIME_TYPES[i].type);
+            }
+        }
+    }
+    return (const __FlashStringHelper *)TYPE_OTHER;
+}
+
+// records the files of the SD card root in files[], reading each one
+// once for its content hash; a file whose path hash is already taken
+// is left out, with a warning, and answered with a 404
+void FileScan(void) {
+    File root = SD.open("/");
+
+    if (!root) {
+        return;
+    }
+    for (File f = root.openNextFile(); f; f = root.openNextFile()) {
+        uint16_t hash = PathHashStep(PATH_HASH_INIT, '/');
+        FileInfo *info = &files[fileNum];
+        byte *buf = tx.block();     // free until the server starts
+        int n;
+
+        for (const char *p = f.name(); *p; p++) {
+            hash = PathHashStep(hash, ToLower(*p));
+        }
+        if (!f.isDirectory() && fileNum < FILE_NUM && FileFind(hash)) {
+            Serial.print(F("WARNING - same path hash as another file: "));
+            Serial.println(f.name());
+        }
+        if (f.isDirectory() || fileNum == FILE_NUM || FileFind(hash)) {
+            f.close();
+            continue;
+        }
+        info->hash = hash;
+        info->size = f.size();
+        info->contentHash = PATH_HASH_INIT;
+        while ((n = f.read(buf, TX_BUF_SZ)) > 0) {
+            for (int i = 0; i < n; i++) {
+                info->contentHash = PathHashStep(info->contentHash, buf[i]);
+            }
+        }
+        f.close();
+        fileNum++;
+    }
+    root.close();
+}
+
+// the cache entry of the file with PathHash() hash, NULL if none
+FileInfo *FileFind(uint16_t hash) {
+    for (byte i = 0; i < fileNum; i++) {
+        if (files[i].hash == hash) {
+            return &files[i];
+        }
+    }
+    return NULL;
+}
+
+// Ajax request, switches the RELAYs and sends the XML file
+// the complete response is sent with a single write
+void SendButtonState(Conn *conn) {
+    SetRELAYs(&conn->req);
+    if (NotModified(conn, 'x')) {
+        return;
+    }
+    XML_update();
+    XML_field(XML_CONN_OFF, XML_CONN_W,
+              conn->req.keepAlive ? XML_KEEP_ALIVE : XML_CLOSE);
+    conn->client.write((const uint8_t *)XML_resp, XML_RESP_LEN);
+    STAT_ADD(socketCalls, 1);
+    STAT_ADD(writes, 1);
+}
+
+// if the client already has the current state in the representation
+// of kind, as told by If-None-Match, sends a 304 and returns true
+boolean NotModified(Conn *conn, char kind) {
+    if (!ETagMatch(&conn->req, kind, stateVersion)) {
+        return false;
+    }
+    SendHeader(conn, F("304 Not Modified"), NULL, NO_LENGTH, kind);
+    tx.flush();
+    return true;
+}
+
+// true if If-None-Match of req names the ETag of kind and value
+boolean ETagMatch(HttpRequest *req, char kind, unsigned long value) {
+    return (req->etagKind & ~ETAG_DONE) == kind && req->etagVersion == value;
+}
+
+// compact alternative to button_state, switches the RELAYs and sends
+// the relay bitmask (bit 0 is RELAY1) and the temperature in degrees
+// as "5 23" in plain text, or as {"relays":5,"temp":23} for
+// /state.json and for requests that accept application/json
+// with v=<version> in the query string, the version of a previous
+// answer's ETag, the request is parked until the state has changed
+void SendState(Conn *conn) {
+    char body[32];
+    char *p = body;
+    boolean json = conn->req.acceptJson ||
+                   conn->req.pathHash == HASH_STATE_JSON;
+
+    SetRELAYs(&conn->req);
+    if (conn->req.longPoll && conn->req.waitVersion == stateVersion) {
+        if (!SubscribeRefused(conn)) {
+            ConnStage(conn, ST_WAIT);   // ConnService() calls back later
+        }
+        return;
+    }
+    if (NotModified(conn, json ? 'j' : 't')) {
+        return;
+    }
+    p = StateBody(p, json);
+
+    SendHeader(conn, F("200 OK"),
+               json ? F("application/json") : F("text/plain"), p - body,
+               json ? 'j' : 't');
+    tx.write((const uint8_t *)body, p - body);
+    tx.flush();
+}
+
+// writes the state as text or JSON to p, not null terminated, at most
+// 31 characters; returns the end
+char *StateBody(char *p, boolean json) {
+    if (json) {
+        strcpy_P(p, PSTR("{\"relays\":"));
+        p += strlen(p);
+    }
+    itoa(RelayMask(), p, 10);
+    p += strlen(p);
+    strcpy_P(p, json ? PSTR(",\"temp\":") : PSTR(" "));
+    p += strlen(p);
+    itoa(celsius, p, 10);
+    p += strlen(p);
+    if (json) {
+        *p++ = '}';
+    }
+    return p;
+}
+
+// subscribes the connection to state events, EventsPush() then sends
+// the current state unless Last-Event-ID says the client has it
+// the stream has no length, so the connection ends with it
+void SendEvents(Conn *conn) {
+    SetRELAYs(&conn->req);
+    if (SubscribeRefused(conn)) {
+        return;
+    }
+    conn->req.keepAlive = false;
+    SendHeader(conn, F("200 OK"), F("text/event-stream"), NO_LENGTH, 0);
+    tx.print(F("retry: 2000\n\n"));
+    tx.flush();
+    ConnStage(conn, ST_STREAM);
+}
+
+// completes the WebSocket handshake, answering Sec-WebSocket-Key with
+// base64(SHA-1(key + WS_GUID)); the connection then carries frames,
+// parsed by WsParse(), and the state is pushed by EventsPush()
+// the SHA-1 state lives in the tx buffer until the response starts and
+// the digest in wsKey, which is done with once hashed, so the handshake
+// needs no stack for either
+void SendWebSocket(Conn *conn) {
+    Sha1 *sha;
+    byte *digest = (byte *)wsKey;
+
+    if (SubscribeRefused(conn)) {
+        if (wsKeyOwner == &conn->req) {
+            wsKeyOwner = NULL;
+        }
+        return;
+    }
+    if (!conn->req.upgradeWs || wsKeyOwner != &conn->req ||
+            wsKeyLen != WS_KEY_LEN) {
+        if (wsKeyOwner == &conn->req) {
+            wsKeyOwner = NULL;
+        }
+        conn->req.keepAlive = false;
+        SendStatus(conn, F("400 Bad Request"));
+        return;
+    }
+    sha = (Sha1 *)tx.block();
+    Sha1Begin(sha);
+    for (byte i = 0; i < WS_KEY_LEN; i++) {
+        Sha1Byte(sha, wsKey[i]);
+    }
+    for (byte i = 0; i < sizeof(WS_GUID) - 1; i++) {
+        Sha1Byte(sha, pgm_read_byte(&WS_GUID[i]));
+    }
+    Sha1End(sha, digest);
+
+    tx.begin(conn->client);
+    tx.print(F("HTTP/1.1 101 Switching Protocols\r\n"
+               "Upgrade: websocket\r\n"
+               "Connection: Upgrade\r\n"
+               "Sec-WebSocket-Accept: "));
+    Base64(digest, SHA1_DIGEST_SZ, tx);
+    tx.print(F("\r\n\r\n"));
+    tx.flush();
+    wsKeyOwner = NULL;
+
+    // the request is done with, its memory now holds the WsConn
+    conn->ws.state = WF_HEAD;
+    conn->ws.opcode = WS_OP_CONT;
+    conn->ws.sentVersion = 0;
+    ConnStage(conn, ST_WEBSOCKET);
+}
+
+// feeds one received byte into the frame parser of a WebSocket
+// a binary frame carries RELAY commands, one byte each, applied as soon
+// as they arrive; returns false when the connection has to be closed
+boolean WsParse(Conn *conn, byte c) {
+    WsConn *ws = &conn->ws;
+
+    switch (ws->state) {
+    case WF_HEAD:
+        // fragments of a message continue with the opcode of its start
+        if ((c & 0x0F) != WS_OP_CONT) {
+            ws->opcode = c & 0x0F;
+        }
+        ws->state = WF_LEN;
+        break;
+
+    case WF_LEN:
+        // frames from the client are always masked, longer payloads than
+        // 16 bit lengths allow are never sent by the page
+        ws->remaining = c & 0x7F;
+        if (!(c & 0x80) || ws->remaining == 127) {
+            return false;
+        }
+        if (ws->opcode >= WS_OP_CLOSE && ws->remaining > WS_CTL_MAX) {
+            return false;
+        }
+        ws->state = (ws->remaining == 126) ? WF_LEN_HI : WF_MASK;
+        ws->pos = 0;
+        break;
+
+    case WF_LEN_HI:
+        ws->remaining = (uint16_t)c << 8;
+        ws->state = WF_LEN_LO;
+        break;
+
+    case WF_LEN_LO:
+        ws->remaining |= c;
+        ws->state = WF_MASK;
+        break;
+
+    case WF_MASK:
+        ws->mask[ws->pos++] = c;
+        if (ws->pos == 4) {
+            ws->pos = 0;
+            ws->ctlLen = (ws->remaining < WS_CTL_SZ) ? ws->remaining : WS_CTL_SZ;
+            if (ws->remaining == 0) {
+                WsFrameEnd(conn);
+                return ws->opcode != WS_OP_CLOSE;
+            }
+            ws->state = WF_DATA;
+        }
+        break;
+
+    case WF_DATA:
+        c ^= ws->mask[ws->pos & 3];
+        if (ws->opcode == WS_OP_BINARY) {
+            byte n = c & ~WS_CMD_ON;
+
+            if (n >= 1 && n <= BTN_NUM) {
+                SetRELAY(n - 1, c & WS_CMD_ON);
+            }
+        }
+        else if (ws->opcode == WS_OP_PING && ws->pos < WS_CTL_SZ) {
+            ws->ctl[ws->pos] = c;
+        }
+        ws->pos++;
+        if (--ws->remaining == 0) {
+            WsFrameEnd(conn);
+            return ws->opcode != WS_OP_CLOSE;
+        }
+        break;
+    }
+    return true;
+}
+
+// called after the last byte of a frame, answers control frames
+void WsFrameEnd(Conn *conn) {
+    WsConn *ws = &conn->ws;
+
+    if (ws->opcode == WS_OP_PING) {
+        WsSend(conn, WS_OP_PONG, ws->ctl, ws->ctlLen);
+    }
+    else if (ws->opcode == WS_OP_CLOSE) {
+        WsSend(conn, WS_OP_CLOSE, NULL, 0);
+    }
+    ws->state = WF_HEAD;
+    ConnStage(conn, ST_WEBSOCKET);
+}
+
+// sends an unfragmented frame of up to 125 bytes, returns false if the
+// socket has no room for it
+boolean WsSend(Conn *conn, byte opcode, const byte *data, byte len) {
+    if (!ConnRoom(conn, 2 + len)) {
+        return false;
+    }
+    tx.begin(conn->client);
+    tx.write(WS_FIN | opcode);
+    tx.write(len);
+    if (len) {
+        tx.write(data, len);
+    }
+    tx.flush();
+    return true;
+}
+
+// moves the bytes waiting in the socket of cl into ring
+// one available() call and at most two read() calls per block,
+// instead of one available() and one read() call per byte
+// returns the number of bytes moved
+int RxFill(RxRing *ring, EthernetClient &cl) {
+    int avail = cl.available();
+    int total = 0;
+
+    STAT_ADD(socketCalls, 1);
+    // an empty ring starts over, so a block is not split in two reads
+    // where the buffer wraps
+    if (ring->head == ring->tail) {
+        ring->head = 0;
+        ring->tail = 0;
+    }
+    while (avail > 0) {
+        byte used = ring->head - ring->tail;
+        byte pos = ring->head & (RX_BUF_SZ - 1);
+        // free space up to the end of the buffer
+        int n = RX_BUF_SZ - pos;
+
+        if (n > RX_BUF_SZ - used) {
+            n = RX_BUF_SZ - used;
+        }
+        if (n > avail) {
+            n = avail;
+        }
+        if (n <= 0) {
+            break;      // ring full, parser has to catch up first
+        }
+        n = cl.read(ring->buf + pos, n);
+        STAT_ADD(socketCalls, 1);
+        if (n <= 0) {
+            break;
+        }
+        ring->head += n;
+        avail -= n;
+        total += n;
+    }
+    return total;
+}
+
+#ifdef DEBUG_STATS
+// prints the average number of socket calls per request
+void PrintStats(void) {
+    stats.requests++;
+    Serial.print(F("requests: "));
+    Serial.print(stats.requests);
+    Serial.print(F(" socket calls/request: "));
+    Serial.print(stats.socketCalls / stats.requests);
+    Serial.print(F(" writes/request: "));
+    Serial.print(stats.writes / stats.requests);
+    Serial.print(F(" file reads/request: "));
+    Serial.println(stats.fileReads / stats.requests);
+    Serial.print(F("dropped idle/header/drain/reserve: "));
+    for (byte i = 0; i < DROP_NUM; i++) {
+        Serial.print(drops[i]);
+        Serial.print(i < DROP_NUM - 1 ? '/' : '\n');
+    }
+    if (stats.minFreeRam) {
+        Serial.print(F("min free SRAM in WebSocket handshake: "));
+        Serial.println(stats.minFreeRam);
+    }
+}
+
+// records the free SRAM if it is the least seen so far
+void StatRam(void) {
+    int n = FreeRam();
+
+    if (stats.minFreeRam == 0 || n < stats.minFreeRam) {
+        stats.minFreeRam = n;
+    }
+}
+
+// bytes of SRAM between the heap and the stack
+int FreeRam(void) {
+#ifdef __AVR__
+    extern int __heap_start, *__brkval;
+    int v;
+
+    return (int)&v - (__brkval == 0 ? (int)&__heap_start : (int)__brkval);
+#else
+    return 0;
+#endif
+}
+#endif
+
+// prepares req to receive a new request
+void RequestBegin(HttpRequest *req) {
+    req->state = PS_METHOD;
+    req->method = METHOD_GET;
+    req->index = 0;
+    req->keepAlive = false;
+    req->acceptJson = false;
+    req->acceptGzip = false;
+    req->etagKind = 0;
+    req->etagVersion = 0;
+    req->header = HDR_OTHER;
+    req->pathTooLong = false;
+    req->path[0] = 0;
+    req->pathLen = 0;
+    req->pathHash = PATH_HASH_INIT;
+    req->relayMatch = 0;
+    req->relayOn = 0;
+    req->relayOff = 0;
+    req->waitMatch = WM_KEY;
+    req->longPoll = false;
+    req->waitVersion = 0;
+    req->upgradeWs = false;
+    if (wsKeyOwner == req) {
+        wsKeyOwner = NULL;      // handshake abandoned
+    }
+}
+
+// appends c to the null terminated string buf of capacity size
+// characters that do not fit are dropped, returns 0 if c was dropped
+char StrAppend(char *buf, byte *len, byte size, char c) {
+    if (*len >= size - 1) {
+        return 0;
+    }
+    buf[(*len)++] = c;
+    buf[*len] = 0;
+    return 1;
+}
+
+// relay command matcher, a DFA fed every character of the query string
+// recognizes RELAYn=1 and RELAYn=0 for any relay n in one pass,
+// the work per character does not depend on the number of relays
+void RelayMatch(HttpRequest *req, char c) {
+    byte m = req->relayMatch;
+
+    if (m < RM_NUMBER) {
+        m = (c == (char)pgm_read_byte(&RELAY_KEY[m])) ? m + 1 : RM_FAIL;
+        req->relayNum = 0;
+    }
+    else if (m == RM_NUMBER) {
+        if (c >= '0' && c <= '9' && req->relayNum <= BTN_NUM) {
+            req->relayNum = req->relayNum * 10 + (c - '0');
+        }
+        else if (c == '=' && req->relayNum >= 1 && req->relayNum <= BTN_NUM) {
+            m = RM_VALUE;
+        }
+        else {
+            m = RM_FAIL;
+        }
+    }
+    else if (m == RM_VALUE && (c == '0' || c == '1')) {
+        req->relayValue = (c == '1');
+        m = RM_MATCH;
+    }
+    else {
+        m = RM_FAIL;
+    }
+    req->relayMatch = m;
+}
+
+// long-poll parameter matcher, fed every character of the query string
+// like RelayMatch(), recognizes v=<digits>
+void WaitMatch(HttpRequest *req, char c) {
+    byte m = req->waitMatch;
+
+    if (m == WM_KEY && c == 'v') {
+        m = WM_EQUALS;
+    }
+    else if (m == WM_EQUALS && c == '=') {
+        m = WM_FIRST;
+        req->waitVersion = 0;
+    }
+    else if ((m == WM_FIRST || m == WM_DIGITS) && c >= '0' && c <= '9') {
+        req->waitVersion = req->waitVersion * 10 + (c - '0');
+        m = WM_DIGITS;
+    }
+    else {
+        m = WM_FAIL;
+    }
+    req->waitMatch = m;
+}
+
+// called at the end of every key=value pair in the query string
+void QueryParam(HttpRequest *req) {
+    if (req->waitMatch == WM_DIGITS) {
+        req->longPoll = true;
+    }
+    req->waitMatch = WM_KEY;
+    if (req->relayMatch == RM_MATCH) {
+        byte bit = 1 << (req->relayNum - 1);
+
+        if (req->relayValue) {
+            req->relayOn |= bit;
+        }
+        else {
+            req->relayOff |= bit;
+        }
+    }
+    req->relayMatch = 0;
+}
+
+// lower case of an ASCII character
+char ToLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
+// header id for the PathHash() of a lower case header name
+byte HeaderId(uint16_t hash) {
+    switch (hash) {
+    case PathHash("connection"):
+        return HDR_CONNECTION;
+    case PathHash("accept"):
+        return HDR_ACCEPT;
+    case PathHash("if-none-match"):
+        return HDR_IF_NONE_MATCH;
+    case PathHash("last-event-id"):
+        return HDR_LAST_EVENT_ID;
+    case PathHash("upgrade"):
+        return HDR_UPGRADE;
+    case PathHash("sec-websocket-key"):
+        return HDR_WS_KEY;
+    case PathHash("accept-encoding"):
+        return HDR_ACCEPT_ENCODING;
+    }
+    return HDR_OTHER;
+}
+
+// called for every comma separated token of the headers parsed
+// parameters after ';' are not part of the token
+void HeaderToken(HttpRequest *req) {
+    if (req->header == HDR_CONNECTION) {
+        if (req->hash == HASH_CLOSE) {
+            req->keepAlive = false;
+        }
+        else if (req->hash == HASH_KEEP_ALIVE) {
+            req->keepAlive = true;
+        }
+    }
+    else if (req->header == HDR_ACCEPT) {
+        if (req->hash == HASH_JSON) {
+            req->acceptJson = true;
+        }
+    }
+    else if (req->header == HDR_ACCEPT_ENCODING) {
+        if (req->hash == HASH_GZIP) {
+            req->acceptGzip = true;
+        }
+    }
+    else if (req->header == HDR_UPGRADE) {
+        if (req->hash == HASH_WEBSOCKET) {
+            req->upgradeWs = true;
+        }
+    }
+}
+
+// collects Sec-WebSocket-Key into wsKey, unless another connection is
+// in the middle of its handshake; SendWebSocket() then refuses this one
+void WsKeyChar(HttpRequest *req, char c) {
+    if (c == ' ' || c == '\t' || c == '\r') {
+        return;
+    }
+    if (wsKeyOwner == NULL) {
+        wsKeyOwner = req;
+        wsKeyLen = 0;
+    }
+    if (wsKeyOwner == req) {
+        if (wsKeyLen < WS_KEY_LEN) {
+            wsKey[wsKeyLen] = c;
+        }
+        wsKeyLen = (wsKeyLen < 255) ? wsKeyLen + 1 : 255;
+    }
+}
+
+// parses the first ETag of If-None-Match, a kind letter and the state
+// version, for example W/"j1234"; only the first ETag is compared
+void ETagChar(HttpRequest *req, char c) {
+    if (req->etagKind & ETAG_DONE) {
+        return;
+    }
+    if (c >= 'a' && c <= 'z' && req->etagKind == 0) {
+        req->etagKind = c;
+    }
+    else if (c >= '0' && c <= '9' && req->etagKind != 0) {
+        req->etagVersion = req->etagVersion * 10 + (c - '0');
+    }
+    else if (c == ',' && req->etagKind != 0) {
+        req->etagKind |= ETAG_DONE;
+    }
+}
+
+// feeds one received character into the request parser
+// nothing is ever rescanned, so the request and its query string
+// may be any length
+// header names and value tokens are only hashed, a hash compare
+// then tells which of them the server is interested in
+// returns the state of the parser after the character
+byte RequestParse(HttpRequest *req, char c) {
+    switch (req->state) {
+    case PS_METHOD:
+        if (c == ' ') {
+            if (req->index != 3) {
+                req->method = METHOD_OTHER;
+            }
+            req->state = PS_PATH;
+        }
+        else if (req->index >= 3 ||
+                c != (char)pgm_read_byte(&METHOD_GET_STR[req->index])) {
+            req->method = METHOD_OTHER;
+        }
+        else {
+            req->index++;
+        }
+        break;
+
+    case PS_PATH:
+        // the web page sends its parameters after '&' instead of '?'
+        if (c == '?' || c == '&') {
+            req->state = PS_QUERY_KEY;
+        }
+        else if (c == ' ') {
+            req->state = PS_VERSION;
+            req->index = 0;
+        }
+        else if (c == '\n') {
+            req->state = PS_DONE;   // HTTP/0.9 style request, no headers
+        }
+        else if (c != '\r') {
+            req->pathHash = PathHashStep(req->pathHash, c);
+            if (!StrAppend(req->path, &req->pathLen, PATH_BUF_SZ, c)) {
+                req->pathTooLong = true;
+            }
+        }
+        break;
+
+    case PS_QUERY_KEY:
+    case PS_QUERY_VAL:
+        if (c == '&' || c == ' ') {
+            QueryParam(req);
+            req->state = (c == ' ') ? PS_VERSION : PS_QUERY_KEY;
+            req->index = 0;
+        }
+        else {
+            if (c == '=' && req->state == PS_QUERY_KEY) {
+                req->state = PS_QUERY_VAL;
+            }
+            RelayMatch(req, c);
+            WaitMatch(req, c);
+        }
+        break;
+
+    case PS_VERSION:
+        // connections are kept alive by default from HTTP/1.1 on
+        if (c == '\n') {
+            req->keepAlive = (req->index == sizeof(HTTP_VERSION) - 1);
+            req->state = PS_HEADER_NAME;
+            req->index = 0;
+            req->hash = PATH_HASH_INIT;
+        }
+        else if (c != '\r') {
+            if (req->index < sizeof(HTTP_VERSION) - 1 &&
+                    c == (char)pgm_read_byte(&HTTP_VERSION[req->index])) {
+                req->index++;
+            }
+            else {
+                req->index = 0xFF;
+            }
+        }
+        break;
+
+    case PS_HEADER_NAME:
+        // every line of text received from the client ends with \r\n
+        // the last line of the request is blank
+        if (c == '\n') {
+            if (req->index == 0) {
+                req->state = PS_DONE;
+            }
+            req->index = 0;
+            req->hash = PATH_HASH_INIT;
+        }
+        else if (c == ':') {
+            req->header = HeaderId(req->hash);
+            req->state = PS_HEADER_VALUE;
+            req->index = 0;
+            req->hash = PATH_HASH_INIT;
+            req->skipToken = false;
+        }
+        else if (c != '\r') {
+            req->hash = PathHashStep(req->hash, ToLower(c));
+            req->index = 1;
+        }
+        break;
+
+    case PS_HEADER_VALUE:
+        if (c == ',' || c == '\n') {
+            if (req->index != 0) {
+                HeaderToken(req);
+            }
+            if (req->header == HDR_IF_NONE_MATCH) {
+                ETagChar(req, c);
+            }
+            req->index = 0;
+            req->hash = PATH_HASH_INIT;
+            req->skipToken = false;
+            if (c == '\n') {
+                req->state = PS_HEADER_NAME;
+            }
+        }
+        else if (c == ';') {
+            req->skipToken = true;
+        }
+        else if (req->header == HDR_IF_NONE_MATCH) {
+            ETagChar(req, c);
+        }
+        else if (req->header == HDR_WS_KEY) {
+            WsKeyChar(req, c);
+        }
+        else if (req->header == HDR_LAST_EVENT_ID) {
+            if (c >= '0' && c <= '9') {
+                req->waitVersion = req->waitVersion * 10 + (c - '0');
+            }
+        }
+        else if (c != ' ' && c != '\t' && c != '\r' && !req->skipToken) {
+            req->hash = PathHashStep(req->hash, ToLower(c));
+            req->index = 1;
+        }
+        break;
+    }
+
+    return req->state;
+}
+
+// SHA-1 as in FIPS 180-4, one byte at a time, with the 80 word message
+// schedule computed in place in the 64 byte block
+uint32_t Rol(uint32_t x, byte n) {
+    return (x << n) | (x >> (32 - n));
+}
+
+void Sha1Begin(Sha1 *sha) {
+    sha->h[0] = 0x67452301UL;
+    sha->h[1] = 0xEFCDAB89UL;
+    sha->h[2] = 0x98BADCFEUL;
+    sha->h[3] = 0x10325476UL;
+    sha->h[4] = 0xC3D2E1F0UL;
+    sha->len = 0;
+    sha->total = 0;
+}
+
+void Sha1Byte(Sha1 *sha, byte c) {
+    sha->b[sha->len++] = c;
+    sha->total++;
+    if (sha->len == 64) {
+        Sha1Block(sha);
+    }
+}
+
+void Sha1Block(Sha1 *sha) {
+    uint32_t a = sha->h[0], b = sha->h[1], c = sha->h[2];
+    uint32_t d = sha->h[3], e = sha->h[4];
+
+    STAT_RAM();     // the deepest point of the handshake
+
+    // the block bytes are big endian words
+    for (byte i = 0; i < 16; i++) {
+        byte *p = &sha->b[i * 4];
+
+        sha->w[i] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+                    ((uint32_t)p[2] << 8) | p[3];
+    }
+    for (byte i = 0; i < 80; i++) {
+        uint32_t f, k, t;
+
+        if (i >= 16) {
+            t = sha->w[(i + 13) & 15] ^ sha->w[(i + 8) & 15] ^
+                sha->w[(i + 2) & 15] ^ sha->w[i & 15];
+            sha->w[i & 15] = Rol(t, 1);
+        }
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999UL;
+        }
+        else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1UL;
+        }
+        else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDCUL;
+        }
+        else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6UL;
+        }
+        t = Rol(a, 5) + f + e + k + sha->w[i & 15];
+        e = d;
+        d = c;
+        c = Rol(b, 30);
+        b = a;
+        a = t;
+    }
+    sha->h[0] += a;
+    sha->h[1] += b;
+    sha->h[2] += c;
+    sha->h[3] += d;
+    sha->h[4] += e;
+    sha->len = 0;
+}
+
+// pads the message and writes the SHA1_DIGEST_SZ byte digest, which
+// may overwrite the message but not sha
+void Sha1End(Sha1 *sha, byte *digest) {
+    unsigned long bits = sha->total * 8;
+
+    Sha1Byte(sha, 0x80);
+    while (sha->len != 56) {
+        Sha1Byte(sha, 0);
+    }
+    // message length in bits, big endian 64 bit
+    for (byte i = 0; i < 4; i++) {
+        Sha1Byte(sha, 0);
+    }
+    for (byte i = 0; i < 4; i++) {
+        Sha1Byte(sha, bits >> (24 - i * 8));
+    }
+    for (byte i = 0; i < SHA1_DIGEST_SZ; i++) {
+        digest[i] = sha->h[i / 4] >> (24 - (i % 4) * 8);
+    }
+}
+
+const char BASE64_CHARS[] PROGMEM =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// prints the base64 encoding of data to out, 4 characters for every
+// 3 bytes or part of them
+void Base64(const byte *data, byte len, Print &out) {
+    for (byte i = 0; i < len; i += 3) {
+        uint32_t v = (uint32_t)data[i] << 16;
+
+        if (i + 1 < len) {
+            v |= (uint32_t)data[i + 1] << 8;
+        }
+        if (i + 2 < len) {
+            v |= data[i + 2];
+        }
+        for (byte j = 0; j < 4; j++) {
+            out.write((i + j <= len) ?
+                      pgm_read_byte(&BASE64_CHARS[(v >> (18 - j * 6)) & 0x3F]) : '=');
+        }
+    }
+}
+
+// switches on/off the RELAYs requested in the query string of req
+// also saves the state of the RELAYs
+void SetRELAYs(HttpRequest *req) {
+    for (byte i = 0; i < BTN_NUM; i++) {
+        boolean on;
+
+        if (req->relayOn & (1 << i)) {
+            on = 1;
+        }
+        else if (req->relayOff & (1 << i)) {
+            on = 0;
+        }
+        else {
+            continue;
+        }
+        SetRELAY(i, on);
+    }
+    // applied once, a parked request is dispatched again later
+    req->relayOn = 0;
+    req->relayOff = 0;
+}
+
+// switches RELAY i+1 on or off and saves its state
+void SetRELAY(byte i, boolean on) {
+    if (RELAY_state[i] != on) {
+        RELAY_state[i] = on;
+        stateVersion++;
+    }
+    digitalWrite(pgm_read_byte(&RELAY_pin[i]), on ? HIGH : LOW);
+}
+
+// the RELAY states as bits, bit 0 is RELAY1
+byte RelayMask(void) {
+    byte mask = 0;
+
+    for (byte i = 0; i < BTN_NUM; i++) {
+        if (RELAY_state[i]) {
+            mask |= 1 << i;
+        }
+    }
+    return mask;
+}
+
+// samples the temperature every TEMP_SAMPLE_MS
+void SampleTemp(void) {
+    if (millis() - tempSampled >= TEMP_SAMPLE_MS) {
+        int t = temp.getTemp();
+
+        tempSampled = millis();
+        if (t != celsius) {
+            celsius = t;
+            stateVersion++;
+        }
+    }
+}
+
+// builds the button_state response in XML_resp
+void XML_init(void) {
+    char *p = XML_resp;
+
+    memcpy_P(p, PSTR(XML_HDR_STATUS), SLEN(XML_HDR_STATUS));
+    p += SLEN(XML_HDR_STATUS);
+    PutDigits(p, XML_LEN_W, XML_BODY_LEN);
+    p += XML_LEN_W;
+    memcpy_P(p, PSTR(XML_HDR_ETAG), SLEN(XML_HDR_ETAG));
+    p += SLEN(XML_HDR_ETAG) + XML_ETAG_W;
+    memcpy_P(p, PSTR(XML_HDR_CONN), SLEN(XML_HDR_CONN));
+    p += SLEN(XML_HDR_CONN) + XML_CONN_W;
+    memcpy_P(p, PSTR(XML_HDR_END), SLEN(XML_HDR_END));
+    p += SLEN(XML_HDR_END);
+    memcpy_P(p, PSTR(XML_HEAD), SLEN(XML_HEAD));
+    p += SLEN(XML_HEAD) + XML_TEMP_W;
+    for (byte i = 0; i < BTN_NUM; i++) {
+        memcpy_P(p, PSTR(XML_BUTTON), SLEN(XML_BUTTON));
+        p += SLEN(XML_BUTTON);
+        XML_field(p - XML_resp, XML_STATE_W, RELAY_state[i] ? XML_ON : XML_OFF);
+        XML_relay[i] = RELAY_state[i];
+        p += XML_STATE_W;
+    }
+    memcpy_P(p, PSTR(XML_TAIL), SLEN(XML_TAIL));
+
+    // force the temperature and ETag fields to be written
+    XML_celsius = ~celsius;
+    XML_version = stateVersion - 1;
+    XML_update();
+}
+
+// patches the fields of XML_resp whose values have changed
+void XML_update(void) {
+    if (XML_version == stateVersion) {
+        return;
+    }
+    XML_version = stateVersion;
+    PutDigits(XML_resp + XML_ETAG_OFF, XML_ETAG_W, stateVersion);
+
+    for (byte i = 0; i < BTN_NUM; i++) {
+        if (XML_relay[i] != RELAY_state[i]) {
+            XML_relay[i] = RELAY_state[i];
+            XML_field(XML_BTN_OFF(i), XML_STATE_W, RELAY_state[i] ? XML_ON : XML_OFF);
+        }
+    }
+    if (XML_celsius != celsius) {
+        char *p = XML_resp + XML_TEMP_OFF;
+        byte n;
+
+        XML_celsius = celsius;
+        // at most 4 characters fit in front of "</temp>"
+        itoa(constrain(celsius, -999, 9999), p, 10);
+        n = strlen(p);
+        memcpy_P(p + n, XML_TEMP_END, SLEN(XML_TEMP_END));
+        n += SLEN(XML_TEMP_END);
+        memset(p + n, ' ', XML_TEMP_W - n);
+    }
+}
+
+// writes value as width decimal digits with leading zeros
+void PutDigits(char *p, byte width, unsigned long value) {
+    while (width > 0) {
+        p[--width] = '0' + value % 10;
+        value /= 10;
+    }
+}
+
+// writes text from flash into the field at offset of XML_resp,
+// padding it with spaces to width
+void XML_field(unsigned int offset, byte width, PGM_P text) {
+    char *p = XML_resp + offset;
+    byte n = strlen_P(text);
+
+    memcpy_P(p, text, n);
+    memset(p + n, ' ', width - n);
 }
@@ -0,0 +1,122 @@
+var btn_state = [0];
+// state version of the last answer, from its ETag
+var version = 0;
+// open WebSocket to the server, if any
+var socket = null;
+
+// compact state: {"relays":<bitmask>,"temp":<degrees>}
+function ShowState(state) {
+  var btnstr = "";
+
+  for (var i = 0; i < 5; i++) {
+    btnstr = "RELAY" + (i + 1);
+
+    if (state.relays & (1 << i)) {
+      document.getElementById(btnstr).innerHTML = "ON";
+      btn_state[i] = 1;
+    }
+    else {
+      document.getElementById(btnstr).innerHTML = "OFF";
+      btn_state[i] = 0;
+    }
+  }
+
+  // Temperature
+  document.getElementById("celsius").innerHTML = state.temp;
+}
+
+// the server pushes every state change on a WebSocket, which also
+// carries the button presses; browsers without WebSocket use
+// /events, or long-poll
+function StartUpdates() {
+  // the server filled in the state it had when it sent the page
+  for (var i = 0; i < 5; i++) {
+    btn_state[i] = (document.getElementById("RELAY" + (i + 1)).innerHTML.indexOf("ON") == 0) ? 1 : 0;
+  }
+
+  if (window.WebSocket && window.DataView) {
+    OpenSocket();
+  }
+  else if (window.EventSource) {
+    var events = new EventSource("events");
+
+    events.onmessage = function(e) {
+      ShowState(JSON.parse(e.data));
+    }
+    // refused while the server has no room for another subscriber
+    events.onerror = function() {
+      if (events.readyState == EventSource.CLOSED) {
+        GetArduinoIO();
+      }
+    }
+  }
+  else {
+    GetArduinoIO();
+  }
+}
+
+// state frames are 3 bytes: RELAY bitmask, temperature as a
+// little endian 16 bit integer
+function OpenSocket() {
+  var ws = new WebSocket("ws://" + location.host + "/ws");
+
+  ws.binaryType = "arraybuffer";
+  ws.onopen = function() {
+    socket = ws;
+  }
+  ws.onmessage = function(e) {
+    var data = new DataView(e.data);
+
+    ShowState({ relays: data.getUint8(0), temp: data.getInt16(1, true) });
+  }
+  ws.onclose = function() {
+    // a socket that never opened was refused, the server has no room
+    // for another subscriber: poll instead
+    if (!socket) {
+      GetArduinoIO();
+      return;
+    }
+    socket = null;
+    setTimeout(OpenSocket, 2000);
+  }
+}
+
+function GetArduinoIO() {
+  var request = new XMLHttpRequest();
+  request.onreadystatechange = function() {
+    if (this.readyState == 4) {
+      if (this.status == 200) {
+        ShowState(JSON.parse(this.responseText));
+        version = parseInt(this.getResponseHeader("ETag").replace(/[^0-9]/g, ""), 10);
+        GetArduinoIO();
+      }
+      else {
+        // server unreachable, or no room to park the request: try
+        // again later, asking for the state right away
+        version = 0;
+        setTimeout('GetArduinoIO()', 1000);
+      }
+    }
+  }
+  // long-poll: the server answers once the state differs from
+  // version, or after a while with the unchanged state
+  request.open("GET", "state.json?v=" + version, true);
+  request.send(null);
+}
+
+// switches a RELAY right away, the new state then arrives as an
+// event or as the answer to the pending long-poll
+// on the WebSocket the command is one byte, the RELAY number
+// plus 0x80 to switch it on
+function GetButton(btn_num_str, btn_num) {
+  var request;
+
+  btn_state[btn_num] = (btn_state[btn_num] === 0) ? 1 : 0;
+  if (socket) {
+    socket.send(new Uint8Array([(parseInt(btn_num, 10) + 1) | (btn_state[btn_num] ? 0x80 : 0)]));
+    return;
+  }
+  request = new XMLHttpRequest();
+  request.open("GET", "state.json?" + btn_num_str + "=" + btn_state[btn_num], true);
+  request.send(null);
+}